@@ -6,6 +6,14 @@
         "src/addon.cpp",
         "src/napi_opencv/napi_opencv.cpp",
         "src/napi_opencv/common/type_converters.cpp",
+        "src/napi_opencv/common/addon_data.cpp",
+        "src/napi_opencv/common/mat_wrap.cpp",
+        "src/napi_opencv/common/allocator.cpp",
+        "src/napi_opencv/common/buffer_pool.cpp",
+        "src/napi_opencv/common/async_job.cpp",
+        "src/napi_opencv/common/job_scheduler.cpp",
+        "src/napi_opencv/common/parallel_backend.cpp",
+        "src/napi_opencv/common/cpu_topology.cpp",
         "src/napi_opencv/core/core.cpp",
         "src/napi_opencv/imgproc/imgproc.cpp",
         "src/napi_opencv/imgcodecs/imgcodecs.cpp",
@@ -15,7 +23,11 @@
         "src/napi_opencv/calib3d/calib3d.cpp",
         "src/napi_opencv/flann/flann.cpp",
         "src/napi_opencv/videoio/videoio.cpp",
-        "src/napi_opencv/gapi/gapi.cpp"
+        "src/napi_opencv/gapi/gapi.cpp",
+        "src/napi_opencv/gapi/gcomputation.cpp",
+        "src/napi_opencv/gapi/compile_cache.cpp",
+        "src/napi_opencv/gapi/gstreaming.cpp",
+        "src/napi_opencv/pipeline/pipeline.cpp"
       ],
         "include_dirs": [
           "<!@(node -p \"require('node-addon-api').include\")",
@@ -96,10 +96,71 @@ class OpenCVBuilder {
       'WITH_PNG': 'ON',
       'WITH_TIFF': 'ON',
       'WITH_OPENJPEG': 'ON',
-      'WITH_JASPER': 'OFF'
+      'WITH_JASPER': 'OFF',
+
+      // 并行后端：内置 pthreads，TBB / OpenMP 以插件形式单独构建，运行时通过 setParallelBackend 切换
+      'WITH_PTHREADS_PF': 'ON',
+      'WITH_TBB': 'OFF',
+      'WITH_OPENMP': 'OFF',
+      'PARALLEL_ENABLE_PLUGINS': 'ON'
     };
   }
 
+  // 要构建的并行后端插件，可通过 OPENCV_PARALLEL_PLUGINS=tbb,openmp 指定，设为空字符串则跳过
+  getParallelPlugins() {
+    const list = process.env.OPENCV_PARALLEL_PLUGINS;
+    if (list === undefined) {
+      return ['tbb', 'openmp'];
+    }
+    return list.split(',').map(name => name.trim().toLowerCase()).filter(name => name);
+  }
+
+  // 插件放在 opencv_world 所在目录，OpenCV 在运行时从该目录按名称查找。
+  // 默认列表中的插件缺少依赖时跳过；OPENCV_PARALLEL_PLUGINS 显式指定的插件构建失败则整个构建失败
+  buildParallelPlugins(platformBuildDir) {
+    const libDir = path.join(platformBuildDir, 'lib');
+    // 指向刚安装的 OpenCV，否则插件的 find_package(OpenCV) 会失败或找到系统中的 OpenCV
+    const opencvCMakeDir = path.join(platformBuildDir, 'lib', 'cmake', 'opencv4');
+    const required = process.env.OPENCV_PARALLEL_PLUGINS !== undefined;
+
+    for (const name of this.getParallelPlugins()) {
+      const pluginSourceDir = path.join(this.opencvSourceDir, 'modules/core/misc/plugins', `parallel_${name}`);
+      if (!fs.existsSync(pluginSourceDir)) {
+        if (required) {
+          throw new Error(`未知的并行后端插件: ${name}`);
+        }
+        this.log(`未知的并行后端插件: ${name}，已跳过`);
+        continue;
+      }
+
+      const pluginBuildDir = path.join(platformBuildDir, 'plugins', `parallel_${name}`);
+      fs.mkdirSync(pluginBuildDir, { recursive: true });
+
+      try {
+        this.log(`构建并行后端插件: ${name}...`);
+        const cmakeArgs = [
+          '-DCMAKE_BUILD_TYPE=Release',
+          `-DOpenCV_DIR="${opencvCMakeDir}"`,
+          `-DOPENCV_PLUGIN_DESTINATION="${libDir}"`,
+          `"${pluginSourceDir}"`
+        ];
+        execSync(`cmake ${cmakeArgs.join(' ')}`, {
+          cwd: pluginBuildDir,
+          stdio: 'inherit'
+        });
+        execSync(`make -j${os.cpus().length}`, {
+          cwd: pluginBuildDir,
+          stdio: 'inherit'
+        });
+      } catch (error) {
+        if (required) {
+          throw new Error(`并行后端插件 ${name} 构建失败: ${error.message}`);
+        }
+        this.log(`并行后端插件 ${name} 构建失败，已跳过: ${error.message}`);
+      }
+    }
+  }
+
   async build() {
     this.log("开始 OpenCV 构建...");
     
@@ -148,6 +209,8 @@ class OpenCVBuilder {
         stdio: 'inherit'
       });
 
+      this.buildParallelPlugins(platformBuildDir);
+
       this.log("OpenCV 构建成功完成!");
       this.log(`构建输出: ${platformBuildDir}`);
       
@@ -0,0 +1,41 @@
+#include "addon_data.h"
+#include "allocator.h"
+#include "job_scheduler.h"
+#include "mat_wrap.h"
+#include <atomic>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        std::atomic<int> liveEnvs{0};
+    } // namespace
+
+    AddonData *CreateAddonData(Napi::Env env)
+    {
+        AddonData *data = new AddonData();
+        data->memoryLedger = std::make_shared<ExternalMemoryLedger>();
+        env.SetInstanceData(data);
+        liveEnvs++;
+
+        // 清理钩子先于实例数据的析构执行，此时仍可访问 JS 值
+        env.AddCleanupHook([data]()
+                           {
+            // 等待本 env 运行中的任务结束，之后 ArrayBuffer 等借用的内存才能随 env 释放
+            if (data->jobQueue) {
+                JobScheduler::Instance().DropEnv(data->jobQueue);
+            }
+            // 丢弃本 env 发出但未被领取的令牌，否则丢失的消息会让像素内存保留到进程退出
+            MatWrap::DropPendingTransfers(data);
+            liveEnvs--; });
+        return data;
+    }
+
+    int LiveEnvCount()
+    {
+        return liveEnvs.load();
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
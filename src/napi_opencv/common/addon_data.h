@@ -0,0 +1,40 @@
+#ifndef NAPI_OPENCV_ADDON_DATA_H
+#define NAPI_OPENCV_ADDON_DATA_H
+
+#include <napi.h>
+#include <memory>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    class EnvJobQueue;
+    struct ExternalMemoryLedger;
+
+    // 每个 env（主线程与各 worker_threads）各自一份的插件状态，JS 对象引用不能跨 env 共享
+    struct AddonData
+    {
+        Napi::FunctionReference matConstructor;
+        Napi::FunctionReference gcomputationConstructor;
+        Napi::FunctionReference gstreamingConstructor;
+        // 后台任务完成后回到本 env 的通道，首次提交任务时创建
+        std::shared_ptr<EnvJobQueue> jobQueue;
+        // 记在本 env 名下的 Mat 像素内存，Mat 可能在 env 退出后才释放，因此共享持有
+        std::shared_ptr<ExternalMemoryLedger> memoryLedger;
+    };
+
+    // 在 Init 开始时调用一次，由 env 在退出时析构；同时注册清理钩子，
+    // 在 env 退出时丢弃它仍在进程级调度器中排队的任务
+    AddonData *CreateAddonData(Napi::Env env);
+
+    // 当前加载了插件的 env 数量；调度器、缓冲池与并行后端由这些 env 共享
+    int LiveEnvCount();
+
+    inline AddonData *GetAddonData(Napi::Env env)
+    {
+        return env.GetInstanceData<AddonData>();
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_ADDON_DATA_H
@@ -0,0 +1,145 @@
+#include "allocator.h"
+#include "addon_data.h"
+#include "buffer_pool.h"
+
+namespace NapiOpenCV {
+namespace Common {
+
+    NodeMatAllocator *NodeMatAllocator::Instance()
+    {
+        // 故意不析构：进程退出时仍可能有 Mat 引用本分配器
+        static NodeMatAllocator *instance = new NodeMatAllocator();
+        return instance;
+    }
+
+    // 与 OpenCV 的 StdMatAllocator 一致，像素内存取自缓冲池并记录分配的字节数
+    cv::UMatData *NodeMatAllocator::allocate(int dims, const int *sizes, int type, void *data0, size_t *step,
+                                             cv::AccessFlag, cv::UMatUsageFlags) const
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--)
+        {
+            if (step)
+            {
+                if (data0 && step[i] != cv::Mat::AUTO_STEP)
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                {
+                    step[i] = total;
+                }
+            }
+            total *= sizes[i];
+        }
+
+        uchar *data = data0 ? static_cast<uchar *>(data0) : static_cast<uchar *>(BufferPool::Instance().Acquire(total));
+        cv::UMatData *u = new cv::UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+
+        if (data0)
+        {
+            u->flags |= cv::UMatData::USER_ALLOCATED;
+        }
+        else
+        {
+            allocatedBytes_.fetch_add(static_cast<int64_t>(total), std::memory_order_relaxed);
+        }
+        return u;
+    }
+
+    bool NodeMatAllocator::allocate(cv::UMatData *u, cv::AccessFlag, cv::UMatUsageFlags) const
+    {
+        return u != nullptr;
+    }
+
+    void NodeMatAllocator::deallocate(cv::UMatData *u) const
+    {
+        if (!u)
+        {
+            return;
+        }
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if (!(u->flags & cv::UMatData::USER_ALLOCATED))
+        {
+            BufferPool::Instance().Release(u->origdata, u->size);
+            u->origdata = nullptr;
+
+            allocatedBytes_.fetch_sub(static_cast<int64_t>(u->size), std::memory_order_relaxed);
+
+            std::shared_ptr<void> context;
+            {
+                std::lock_guard<std::mutex> lock(ledgerMutex_);
+                context.swap(u->allocatorContext);
+            }
+            if (context)
+            {
+                std::static_pointer_cast<ExternalMemoryLedger>(context)->pending.fetch_sub(
+                    static_cast<int64_t>(u->size), std::memory_order_relaxed);
+            }
+        }
+        delete u;
+    }
+
+    void NodeMatAllocator::Attach(Napi::Env env, const cv::Mat &mat) const
+    {
+        cv::UMatData *u = mat.u;
+        if (u != nullptr && u->currAllocator == this && !(u->flags & cv::UMatData::USER_ALLOCATED))
+        {
+            std::shared_ptr<ExternalMemoryLedger> ledger = GetAddonData(env)->memoryLedger;
+            std::shared_ptr<void> previous;
+            {
+                std::lock_guard<std::mutex> lock(ledgerMutex_);
+                if (u->allocatorContext != ledger)
+                {
+                    previous = u->allocatorContext;
+                    u->allocatorContext = ledger;
+                    ledger->pending.fetch_add(static_cast<int64_t>(u->size), std::memory_order_relaxed);
+                }
+            }
+            if (previous)
+            {
+                std::static_pointer_cast<ExternalMemoryLedger>(previous)->pending.fetch_sub(
+                    static_cast<int64_t>(u->size), std::memory_order_relaxed);
+            }
+        }
+        FlushExternalMemory(env);
+    }
+
+    void NodeMatAllocator::FlushExternalMemory(Napi::Env env) const
+    {
+        ExternalMemoryLedger &ledger = *GetAddonData(env)->memoryLedger;
+        int64_t delta = ledger.pending.exchange(0, std::memory_order_relaxed);
+
+        // 汇报值不低于 0：转出到其他 env 的内存可能先于本 env 的汇报被冲减
+        if (ledger.reported + delta < 0)
+        {
+            delta = -ledger.reported;
+        }
+        if (delta != 0)
+        {
+            ledger.reported += delta;
+            Napi::MemoryManagement::AdjustExternalMemory(env, delta);
+        }
+    }
+
+    cv::Mat NewOutputMat()
+    {
+        cv::Mat mat;
+        mat.allocator = NodeMatAllocator::Instance();
+        return mat;
+    }
+
+    cv::Mat CloneMat(const cv::Mat &src)
+    {
+        cv::Mat dst = NewOutputMat();
+        src.copyTo(dst);
+        return dst;
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
@@ -0,0 +1,59 @@
+#ifndef NAPI_OPENCV_ALLOCATOR_H
+#define NAPI_OPENCV_ALLOCATOR_H
+
+#include <napi.h>
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    // 一个 env 应向其 V8 汇报的外部内存。释放可能发生在任意线程，差额累计在 pending 中，由该 env 的 JS 线程汇报
+    struct ExternalMemoryLedger
+    {
+        std::atomic<int64_t> pending{0};
+        // 已汇报给 V8 的字节数，只在 JS 线程访问
+        int64_t reported = 0;
+    };
+
+    // 插件创建的 Mat 使用的分配器：像素内存取自 BufferPool，并把增减汇报给 V8，使 GC 压力跟随真实内存
+    // 像素内存由第一个为它创建句柄的 env 记账（工作线程中的临时结果不计入任何 env），
+    // 记账的 env 保存在 UMatData::allocatorContext 中，释放时只冲减该 env 的差额
+    class NodeMatAllocator : public cv::MatAllocator
+    {
+    public:
+        static NodeMatAllocator *Instance();
+
+        cv::UMatData *allocate(int dims, const int *sizes, int type, void *data, size_t *step,
+                               cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+        bool allocate(cv::UMatData *data, cv::AccessFlag accessflags, cv::UMatUsageFlags usageFlags) const override;
+        void deallocate(cv::UMatData *data) const override;
+
+        // 把 mat 的像素内存记到 env 名下并汇报，只能在 JS 线程调用；
+        // 已记在其他 env 名下的内存（如 adopt() 领取的 Mat）转到 env 名下，非本分配器的内存忽略
+        void Attach(Napi::Env env, const cv::Mat &mat) const;
+
+        // 把 env 尚未汇报的差额交给它的 V8，只能在该 env 的 JS 线程调用
+        void FlushExternalMemory(Napi::Env env) const;
+
+        // 当前由本分配器持有的像素字节数
+        int64_t AllocatedBytes() const { return allocatedBytes_.load(std::memory_order_relaxed); }
+
+    private:
+        mutable std::atomic<int64_t> allocatedBytes_{0};
+        // 保护各 UMatData 的 allocatorContext
+        mutable std::mutex ledgerMutex_;
+    };
+
+    // 创建使用插件分配器的空 Mat，绑定函数的输出都应从这里开始
+    cv::Mat NewOutputMat();
+
+    // 深拷贝到插件分配器管理的内存
+    cv::Mat CloneMat(const cv::Mat &src);
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_ALLOCATOR_H
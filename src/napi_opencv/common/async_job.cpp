@@ -0,0 +1,459 @@
+#include "async_job.h"
+#include "job_scheduler.h"
+#include "mat_wrap.h"
+#include "type_converters.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        // 结果通过 Promise 返回的任务
+        class PromiseJob : public Job
+        {
+        public:
+            PromiseJob(Napi::Env env, const std::vector<Napi::Value> &pins, JobExecute execute, JobResolve resolve)
+                : deferred_(Napi::Promise::Deferred::New(env)),
+                  execute_(std::move(execute)),
+                  resolve_(std::move(resolve))
+            {
+                for (const Napi::Value &value : pins)
+                {
+                    Pin(value);
+
+                    // release() 会解除句柄对借用内存的固定，因此同时固定所属对象本身
+                    MatWrap *wrap = MatWrap::FromValue(value);
+                    if (wrap != nullptr)
+                    {
+                        Pin(wrap->GetOwner());
+                    }
+                }
+            }
+
+            Napi::Promise Promise() const { return deferred_.Promise(); }
+
+            void Reject(Napi::Env env, const std::string &message)
+            {
+                deferred_.Reject(Napi::Error::New(env, message).Value());
+            }
+
+            // 未执行就失败（如队列已满），随后由 Complete 拒绝
+            void Fail(const std::string &message) override
+            {
+                error_ = message;
+                failed_ = true;
+            }
+
+            // signal 触发时：仍在队列中的任务立即移出并拒绝，运行中的任务只设置取消标记
+            void Watch(Napi::Env env, Napi::Object signal)
+            {
+                signal_ = Napi::Persistent(signal);
+                listener_ = Napi::Persistent(Napi::Function::New(env, [this](const Napi::CallbackInfo &info)
+                                                                 {
+                    Cancel();
+                    OnAbort(info.Env()); }));
+
+                Napi::Object once = Napi::Object::New(env);
+                once.Set("once", Napi::Boolean::New(env, true));
+                signal.Get("addEventListener").As<Napi::Function>().Call(signal, {Napi::String::New(env, "abort"), listener_.Value(), once});
+            }
+
+            void RejectAborted(Napi::Env env)
+            {
+                Napi::Value reason = signal_.IsEmpty() ? env.Undefined() : signal_.Value().Get("reason");
+                if (reason.IsUndefined())
+                {
+                    Napi::Error error = Napi::Error::New(env, "操作已取消");
+                    error.Set("name", Napi::String::New(env, "AbortError"));
+                    reason = error.Value();
+                }
+                deferred_.Reject(reason);
+            }
+
+            void Execute() override
+            {
+                try
+                {
+                    execute_();
+                }
+                catch (const cv::Exception &e)
+                {
+                    error_ = "OpenCV 错误: " + std::string(e.what());
+                }
+                catch (const std::exception &e)
+                {
+                    error_ = "错误: " + std::string(e.what());
+                }
+                catch (...)
+                {
+                    error_ = "发生未知错误";
+                }
+                failed_ = !error_.empty();
+            }
+
+            void Complete(Napi::Env env) override
+            {
+                Napi::HandleScope scope(env);
+                Unwatch(env);
+
+                if (IsCancelled())
+                {
+                    RejectAborted(env);
+                    return;
+                }
+                if (failed_)
+                {
+                    Reject(env, error_);
+                    return;
+                }
+
+                try
+                {
+                    deferred_.Resolve(resolve_(env));
+                }
+                catch (const std::exception &e)
+                {
+                    Reject(env, "错误: " + std::string(e.what()));
+                }
+            }
+
+            void Discard() override
+            {
+                for (Napi::ObjectReference &pin : pins_)
+                {
+                    pin.SuppressDestruct();
+                }
+                signal_.SuppressDestruct();
+                listener_.SuppressDestruct();
+            }
+
+        protected:
+            // signal 触发后调用，此时已设置取消标记
+            virtual void OnAbort(Napi::Env env)
+            {
+                if (JobScheduler::Instance().Remove(env, this))
+                {
+                    Complete(env);
+                    delete this;
+                }
+            }
+
+        private:
+            // 任务结束后移除监听器，监听器持有的 this 不会在析构后被调用
+            void Unwatch(Napi::Env env)
+            {
+                if (signal_.IsEmpty())
+                {
+                    return;
+                }
+
+                Napi::Object signal = signal_.Value();
+                signal.Get("removeEventListener").As<Napi::Function>().Call(signal, {Napi::String::New(env, "abort"), listener_.Value()});
+                signal_.Reset();
+                listener_.Reset();
+            }
+
+            void Pin(Napi::Value value)
+            {
+                if (value.IsObject())
+                {
+                    pins_.push_back(Napi::Persistent(value.As<Napi::Object>()));
+                }
+            }
+
+            Napi::Promise::Deferred deferred_;
+            JobExecute execute_;
+            JobResolve resolve_;
+            std::vector<Napi::ObjectReference> pins_;
+            Napi::ObjectReference signal_;
+            Napi::FunctionReference listener_;
+            std::string error_;
+            bool failed_ = false;
+        };
+
+        // 批量调用：每个输入作为独立任务提交，由不同工作线程执行，共享同一个 Promise 与结果数组
+        // 本身不进入调度器，只负责固定参数、监听 signal 与结算；由各输入任务共同持有
+        class BatchJob : public PromiseJob, public std::enable_shared_from_this<BatchJob>
+        {
+        public:
+            BatchJob(Napi::Env env, const std::vector<Napi::Value> &pins, std::shared_ptr<std::vector<cv::Mat>> results,
+                     std::function<cv::Mat(size_t)> compute)
+                : PromiseJob(env, pins, nullptr, [results](Napi::Env env) -> Napi::Value
+                             { return TypeConverter<std::vector<cv::Mat>>::ToNapi(env, *results); }),
+                  results_(std::move(results)),
+                  compute_(std::move(compute))
+            {
+            }
+
+            // 逐个提交输入任务，任一输入无法入队时整体拒绝
+            void Submit(Napi::Env env, const JobOptions &options);
+
+            // 在工作线程执行第 index 个输入；已有输入失败时跳过
+            void Run(size_t index, std::string &error)
+            {
+                if (stopped_)
+                {
+                    return;
+                }
+                try
+                {
+                    (*results_)[index] = compute_(index);
+                }
+                catch (const std::exception &e)
+                {
+                    error = "错误: 第 " + std::to_string(index) + " 个输入: " + e.what();
+                    stopped_ = true;
+                }
+                catch (...)
+                {
+                    error = "错误: 第 " + std::to_string(index) + " 个输入: 发生未知错误";
+                    stopped_ = true;
+                }
+            }
+
+            // 输入任务回到 JS 线程；第一个失败的输入决定拒绝原因，其余仍在队列中的输入被移出
+            void ItemFinished(Napi::Env env, Job *item, const std::string &error)
+            {
+                std::shared_ptr<BatchJob> self = shared_from_this();
+                items_.erase(std::find(items_.begin(), items_.end(), item));
+                if (!error.empty() && !abandoned_)
+                {
+                    Fail(error);
+                    Abandon(env);
+                }
+                Finish(env);
+            }
+
+            // 输入任务被丢弃时调用，可能同时来自多个工作线程
+            void DiscardOnce()
+            {
+                std::call_once(discarded_, [this]()
+                               { Discard(); });
+            }
+
+        protected:
+            void OnAbort(Napi::Env env) override
+            {
+                std::shared_ptr<BatchJob> self = shared_from_this();
+                Abandon(env);
+                Finish(env);
+            }
+
+        private:
+            // 停止剩余输入：队列中的立即移出，运行中的标记为取消
+            void Abandon(Napi::Env env)
+            {
+                abandoned_ = true;
+                stopped_ = true;
+                std::vector<Job *> items = items_;
+                for (Job *item : items)
+                {
+                    item->Cancel();
+                    if (JobScheduler::Instance().Remove(env, item))
+                    {
+                        item->Complete(env);
+                        delete item;
+                    }
+                }
+            }
+
+            // 全部输入结束后结算 Promise
+            void Finish(Napi::Env env)
+            {
+                if (!settled_ && !submitting_ && items_.empty())
+                {
+                    settled_ = true;
+                    Complete(env);
+                }
+            }
+
+            std::shared_ptr<std::vector<cv::Mat>> results_;
+            std::function<cv::Mat(size_t)> compute_;
+            std::atomic<bool> stopped_{false};
+            std::once_flag discarded_;
+            // 以下只在 JS 线程访问：尚未回到 JS 线程的输入任务
+            std::vector<Job *> items_;
+            bool submitting_ = false;
+            bool abandoned_ = false;
+            bool settled_ = false;
+        };
+
+        // 批量调用中的一个输入
+        class BatchItemJob : public Job
+        {
+        public:
+            BatchItemJob(std::shared_ptr<BatchJob> batch, size_t index) : batch_(std::move(batch)), index_(index) {}
+
+            void Execute() override { batch_->Run(index_, error_); }
+            void Complete(Napi::Env env) override { batch_->ItemFinished(env, this, error_); }
+            void Discard() override { batch_->DiscardOnce(); }
+            void Fail(const std::string &message) override { error_ = message; }
+
+        private:
+            std::shared_ptr<BatchJob> batch_;
+            size_t index_;
+            std::string error_;
+        };
+
+        void BatchJob::Submit(Napi::Env env, const JobOptions &options)
+        {
+            std::shared_ptr<BatchJob> self = shared_from_this();
+            submitting_ = true;
+            for (size_t i = 0; i < results_->size() && !abandoned_; i++)
+            {
+                Job *item = new BatchItemJob(self, i);
+                item->SetThreads(options.threads);
+                item->SetPriority(options.priority);
+                items_.push_back(item);
+                if (!JobScheduler::Instance().Submit(env, item))
+                {
+                    item->Fail("任务队列已满");
+                    item->Complete(env);
+                    delete item;
+                }
+            }
+            submitting_ = false;
+            Finish(env);
+        }
+    } // namespace
+
+    JobOptions ParseJobOptions(const Napi::CallbackInfo &info, size_t index)
+    {
+        JobOptions options;
+        size_t last = info.Length() - 1;
+        if (info.Length() <= index || !info[last].IsObject() || info[last].IsArray() || MatWrap::IsInstance(info[last]))
+        {
+            return options;
+        }
+
+        Napi::Object object = info[last].As<Napi::Object>();
+        if (object.Has("threads") && object.Get("threads").IsNumber())
+        {
+            options.threads = std::max(0, object.Get("threads").As<Napi::Number>().Int32Value());
+        }
+        if (object.Has("priority") && object.Get("priority").IsString())
+        {
+            std::string priority = object.Get("priority").As<Napi::String>().Utf8Value();
+            if (priority == "interactive")
+            {
+                options.priority = JobPriority::Interactive;
+            }
+            else if (priority == "bulk")
+            {
+                options.priority = JobPriority::Bulk;
+            }
+            else
+            {
+                throw Napi::RangeError::New(info.Env(), "priority 只能为 'interactive' 或 'bulk'");
+            }
+        }
+        if (object.Has("signal") && object.Get("signal").IsObject())
+        {
+            options.signal = object.Get("signal");
+        }
+        return options;
+    }
+
+    Napi::Promise QueueJob(Napi::Env env, const std::vector<Napi::Value> &pins, const JobOptions &options,
+                           JobExecute execute, JobResolve resolve)
+    {
+        PromiseJob *job = new PromiseJob(env, pins, std::move(execute), std::move(resolve));
+        job->SetThreads(options.threads);
+        job->SetPriority(options.priority);
+        Napi::Promise promise = job->Promise();
+
+        // 已经取消的 signal 不再入队
+        if (!options.signal.IsEmpty() && options.signal.IsObject())
+        {
+            Napi::Object signal = options.signal.As<Napi::Object>();
+            job->Watch(env, signal);
+            if (signal.Get("aborted").ToBoolean().Value())
+            {
+                job->Cancel();
+                job->Complete(env);
+                delete job;
+                return promise;
+            }
+        }
+
+        // 提交成功后任务归调度器所有，完成后在 JS 线程中析构
+        if (!JobScheduler::Instance().Submit(env, job))
+        {
+            job->Fail("任务队列已满");
+            job->Complete(env);
+            delete job;
+        }
+        return promise;
+    }
+
+    Napi::Promise QueueMatJob(Napi::Env env, const std::vector<Napi::Value> &pins, const JobOptions &options,
+                              std::function<cv::Mat()> compute)
+    {
+        auto result = std::make_shared<cv::Mat>();
+        return QueueJob(
+            env, pins, options,
+            [compute, result]()
+            { *result = compute(); },
+            [result](Napi::Env env) -> Napi::Value
+            { return TypeConverter<cv::Mat>::ToNapi(env, *result); });
+    }
+
+    Napi::Promise QueueMatBatchJob(Napi::Env env, const std::vector<Napi::Value> &pins, const JobOptions &options,
+                                   size_t count, std::function<cv::Mat(size_t)> compute)
+    {
+        auto results = std::make_shared<std::vector<cv::Mat>>(count);
+        auto batch = std::make_shared<BatchJob>(env, pins, results, std::move(compute));
+        Napi::Promise promise = batch->Promise();
+
+        if (!options.signal.IsEmpty() && options.signal.IsObject())
+        {
+            Napi::Object signal = options.signal.As<Napi::Object>();
+            batch->Watch(env, signal);
+            if (signal.Get("aborted").ToBoolean().Value())
+            {
+                batch->Cancel();
+                batch->Complete(env);
+                return promise;
+            }
+        }
+
+        // OpenCV 同一时刻只有一个顶层 parallel_for_ 并行执行，因此按输入拆成独立任务，
+        // 每个输入内部的 parallel_for_ 仍按任务的线程预算执行
+        batch->Submit(env, options);
+        return promise;
+    }
+
+    void ThrowIfCancelled()
+    {
+        if (Job::CurrentCancelled())
+        {
+            throw std::runtime_error("操作已取消");
+        }
+    }
+
+    std::vector<Napi::Value> PinArgs(const Napi::CallbackInfo &info)
+    {
+        std::vector<Napi::Value> pins;
+        for (size_t i = 0; i < info.Length(); i++)
+        {
+            pins.push_back(info[i]);
+            if (info[i].IsArray())
+            {
+                Napi::Array array = info[i].As<Napi::Array>();
+                for (uint32_t j = 0; j < array.Length(); j++)
+                {
+                    pins.push_back(array.Get(j));
+                }
+            }
+        }
+        return pins;
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
@@ -0,0 +1,55 @@
+#ifndef NAPI_OPENCV_ASYNC_JOB_H
+#define NAPI_OPENCV_ASYNC_JOB_H
+
+#include <napi.h>
+#include <opencv2/core.hpp>
+#include "job_scheduler.h"
+#include <functional>
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    // 后台任务体，在工作线程中执行，不能访问任何 JS 值
+    using JobExecute = std::function<void()>;
+    // 回到 JS 线程后把结果转换为 JS 值
+    using JobResolve = std::function<Napi::Value(Napi::Env)>;
+
+    // 异步调用末尾可选的选项对象
+    struct JobOptions
+    {
+        // OpenCV 并行区域可用的线程数，0 表示使用调度器的 threadsPerJob
+        int threads = 0;
+        // 'interactive'（默认）或 'bulk'
+        JobPriority priority = JobPriority::Interactive;
+        // AbortSignal，仅在提交期间有效
+        Napi::Value signal;
+    };
+
+    // 位置参数之后的最后一个参数为普通对象时作为选项解析，index 为第一个可选参数的位置
+    JobOptions ParseJobOptions(const Napi::CallbackInfo &info, size_t index);
+
+    // 提交到 JobScheduler 并返回 Promise；pins 中的 JS 值以及 Mat 句柄借用的内存在任务结束前保持存活
+    // 队列已满时 Promise 以 "任务队列已满" 拒绝，'wait' 策略下在等待超时后拒绝
+    Napi::Promise QueueJob(Napi::Env env, const std::vector<Napi::Value> &pins, const JobOptions &options,
+                           JobExecute execute, JobResolve resolve);
+
+    // 结果为单个 Mat 的任务，resolve 为 Mat 句柄
+    Napi::Promise QueueMatJob(Napi::Env env, const std::vector<Napi::Value> &pins, const JobOptions &options,
+                              std::function<cv::Mat()> compute);
+
+    // 一次调用处理 count 个输入，每个输入作为独立任务提交，compute(i) 在各工作线程中并行执行，resolve 为 Mat 句柄数组
+    // threads 与 priority 作用于每个输入；任一输入失败时整体拒绝，其余仍在队列中的输入被移出
+    Napi::Promise QueueMatBatchJob(Napi::Env env, const std::vector<Napi::Value> &pins, const JobOptions &options,
+                                   size_t count, std::function<cv::Mat(size_t)> compute);
+
+    // 多阶段任务在阶段之间调用：所在任务已被 AbortSignal 取消时抛出异常，跳过剩余阶段
+    void ThrowIfCancelled();
+
+    // 把调用的全部参数作为 pins，数组参数同时固定其中的每个元素
+    std::vector<Napi::Value> PinArgs(const Napi::CallbackInfo &info);
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_ASYNC_JOB_H
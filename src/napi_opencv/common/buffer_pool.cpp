@@ -0,0 +1,209 @@
+#include "buffer_pool.h"
+#include "cpu_topology.h"
+#include <opencv2/core.hpp>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        // 超额分配并把原始指针与分配时的节点保存在对齐地址之前，与平台无关
+        void *AlignedAlloc(size_t size, size_t alignment, int node)
+        {
+            void *raw = std::malloc(size + alignment + 2 * sizeof(void *));
+            if (!raw)
+            {
+                throw std::bad_alloc();
+            }
+
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw) + 2 * sizeof(void *);
+            uintptr_t aligned = (start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+            reinterpret_cast<void **>(aligned)[-1] = raw;
+            reinterpret_cast<intptr_t *>(aligned)[-2] = node;
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        // 缓冲归属于分配线程所在的节点
+        int NodeOf(void *ptr)
+        {
+            return static_cast<int>(reinterpret_cast<intptr_t *>(ptr)[-2]);
+        }
+
+        void AlignedFree(void *ptr)
+        {
+            if (ptr)
+            {
+                std::free(reinterpret_cast<void **>(ptr)[-1]);
+            }
+        }
+    } // namespace
+
+    BufferPool &BufferPool::Instance()
+    {
+        // 故意不析构：清理线程与仍存活的 Mat 在进程退出时都可能访问缓冲池
+        static BufferPool *instance = new BufferPool();
+        return *instance;
+    }
+
+    size_t BufferPool::SizeClass(size_t size)
+    {
+        size_t power = 1;
+        while (power <= size / 2)
+        {
+            power <<= 1;
+        }
+
+        size_t step = power / 4 > 0 ? power / 4 : 1;
+        return (size + step - 1) / step * step;
+    }
+
+    void *BufferPool::Acquire(size_t size, size_t alignment)
+    {
+        if (size < kMinPooledBytes)
+        {
+            return cv::fastMalloc(size);
+        }
+
+        int node = CpuTopology::CurrentNode();
+        Key key(SizeClass(size), alignment, node);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lastUse_ = std::chrono::steady_clock::now();
+
+            auto it = freeLists_.find(key);
+            if (it != freeLists_.end() && !it->second.empty())
+            {
+                void *ptr = it->second.back();
+                it->second.pop_back();
+                stats_.hits++;
+                stats_.cachedBytes -= std::get<0>(key);
+                stats_.cachedBuffers--;
+                return ptr;
+            }
+            stats_.misses++;
+        }
+
+        return AlignedAlloc(std::get<0>(key), alignment, node);
+    }
+
+    void BufferPool::Release(void *ptr, size_t size, size_t alignment)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (size < kMinPooledBytes)
+        {
+            cv::fastFree(ptr);
+            return;
+        }
+
+        Key key(SizeClass(size), alignment, NodeOf(ptr));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lastUse_ = std::chrono::steady_clock::now();
+
+            if (stats_.enabled && stats_.cachedBytes + std::get<0>(key) <= stats_.maxBytes)
+            {
+                if (stats_.cachedBuffers == 0)
+                {
+                    trimmerCv_.notify_all();
+                }
+                freeLists_[key].push_back(ptr);
+                stats_.cachedBytes += std::get<0>(key);
+                stats_.cachedBuffers++;
+                StartTrimmerLocked();
+                return;
+            }
+            stats_.evictions++;
+        }
+
+        AlignedFree(ptr);
+    }
+
+    void BufferPool::Configure(size_t maxBytes, int64_t idleMs, bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.maxBytes = maxBytes;
+        stats_.idleMs = idleMs;
+        stats_.enabled = enabled;
+
+        TrimLocked(enabled ? maxBytes : 0);
+        trimmerCv_.notify_all();
+    }
+
+    void BufferPool::Trim(size_t targetBytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TrimLocked(targetBytes);
+    }
+
+    BufferPool::Stats BufferPool::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    // 从最大的档位开始释放，尽快把缓存降到目标以下
+    void BufferPool::TrimLocked(size_t targetBytes)
+    {
+        if (stats_.cachedBytes <= targetBytes)
+        {
+            return;
+        }
+
+        for (auto it = freeLists_.rbegin(); it != freeLists_.rend() && stats_.cachedBytes > targetBytes; ++it)
+        {
+            std::vector<void *> &list = it->second;
+            while (!list.empty() && stats_.cachedBytes > targetBytes)
+            {
+                AlignedFree(list.back());
+                list.pop_back();
+                stats_.cachedBytes -= std::get<0>(it->first);
+                stats_.cachedBuffers--;
+            }
+        }
+        stats_.trims++;
+    }
+
+    void BufferPool::StartTrimmerLocked()
+    {
+        if (trimmerStarted_)
+        {
+            return;
+        }
+
+        trimmerStarted_ = true;
+        std::thread(&BufferPool::TrimmerLoop, this).detach();
+    }
+
+    // 缓冲池空闲超过 idleMs 后把缓存全部还给系统
+    void BufferPool::TrimmerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            // 没有缓存或关闭自动清理时，等待下一次放回缓存或重新配置
+            if (stats_.idleMs <= 0 || stats_.cachedBuffers == 0)
+            {
+                trimmerCv_.wait(lock);
+                continue;
+            }
+
+            auto idle = std::chrono::milliseconds(stats_.idleMs);
+            auto deadline = lastUse_ + idle;
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                TrimLocked(0);
+                continue;
+            }
+            trimmerCv_.wait_until(lock, deadline);
+        }
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
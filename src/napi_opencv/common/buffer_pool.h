@@ -0,0 +1,73 @@
+#ifndef NAPI_OPENCV_BUFFER_POOL_H
+#define NAPI_OPENCV_BUFFER_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    // 进程级的像素缓冲池：按 (容量档位, 对齐, NUMA 节点) 缓存释放的内存，供后续同尺寸的输出 Mat 复用
+    // 缓冲记录分配时所在线程的节点，只复用给同一节点的线程；小于 kMinPooledBytes 的请求直接走 cv::fastMalloc
+    class BufferPool
+    {
+    public:
+        static constexpr size_t kMinPooledBytes = 16 * 1024;
+        static constexpr size_t kDefaultAlignment = 64;
+
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint64_t trims = 0;
+            size_t cachedBytes = 0;
+            size_t cachedBuffers = 0;
+            size_t maxBytes = 0;
+            int64_t idleMs = 0;
+            bool enabled = true;
+        };
+
+        static BufferPool &Instance();
+
+        // size 相同的 Acquire/Release 必须成对使用，容量档位由 size 决定
+        void *Acquire(size_t size, size_t alignment = kDefaultAlignment);
+        void Release(void *ptr, size_t size, size_t alignment = kDefaultAlignment);
+
+        // maxBytes 为缓存上限，idleMs 为空闲多久后清空缓存（0 表示不自动清理）
+        void Configure(size_t maxBytes, int64_t idleMs, bool enabled);
+        // 释放缓存，直到缓存字节数不超过 targetBytes
+        void Trim(size_t targetBytes = 0);
+        Stats GetStats();
+
+        // 请求尺寸向上取整后的容量，每个 2 的幂区间分为 4 档，浪费不超过 25%
+        static size_t SizeClass(size_t size);
+
+    private:
+        BufferPool() = default;
+
+        void TrimLocked(size_t targetBytes);
+        void StartTrimmerLocked();
+        void TrimmerLoop();
+
+        // (容量档位, 对齐, 节点)，按容量排序以便 TrimLocked 先释放大缓冲
+        using Key = std::tuple<size_t, size_t, int>;
+
+        std::mutex mutex_;
+        std::condition_variable trimmerCv_;
+        std::map<Key, std::vector<void *>> freeLists_;
+        std::chrono::steady_clock::time_point lastUse_ = std::chrono::steady_clock::now();
+        bool trimmerStarted_ = false;
+        Stats stats_{0, 0, 0, 0, 0, 0, 256 * 1024 * 1024, 5000, true};
+    };
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_BUFFER_POOL_H
@@ -0,0 +1,191 @@
+#include "cpu_topology.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        thread_local int currentNode = 0;
+
+#ifdef __linux__
+        // 解析 "0-3,8-11" 形式的 CPU 列表
+        std::vector<int> ParseCpuList(const std::string &text)
+        {
+            std::vector<int> cpus;
+            std::stringstream stream(text);
+            std::string range;
+            while (std::getline(stream, range, ','))
+            {
+                if (range.empty() || range == "\n")
+                {
+                    continue;
+                }
+
+                size_t dash = range.find('-');
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; cpu++)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            return cpus;
+        }
+
+        std::vector<int> AllowedCpus()
+        {
+            std::vector<int> cpus;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+            return cpus;
+        }
+#endif
+    } // namespace
+
+    const CpuTopology &CpuTopology::Get()
+    {
+        static CpuTopology topology;
+        return topology;
+    }
+
+    CpuTopology::CpuTopology()
+    {
+#ifdef __linux__
+        // 只保留进程允许使用的 CPU（容器、taskset 等限制）
+        std::vector<int> allowed = AllowedCpus();
+
+        DIR *dir = opendir("/sys/devices/system/node");
+        if (dir != nullptr)
+        {
+            while (dirent *entry = readdir(dir))
+            {
+                std::string name = entry->d_name;
+                if (name.compare(0, 4, "node") != 0 || name.size() == 4 ||
+                    !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+                {
+                    continue;
+                }
+
+                std::ifstream file("/sys/devices/system/node/" + name + "/cpulist");
+                std::string text;
+                if (!std::getline(file, text))
+                {
+                    continue;
+                }
+
+                NumaNode node;
+                node.id = std::stoi(name.substr(4));
+                for (int cpu : ParseCpuList(text))
+                {
+                    if (allowed.empty() || std::find(allowed.begin(), allowed.end(), cpu) != allowed.end())
+                    {
+                        node.cpus.push_back(cpu);
+                    }
+                }
+                if (!node.cpus.empty())
+                {
+                    nodes_.push_back(node);
+                }
+            }
+            closedir(dir);
+        }
+
+        std::sort(nodes_.begin(), nodes_.end(), [](const NumaNode &a, const NumaNode &b)
+                  { return a.id < b.id; });
+
+        // 没有 NUMA 信息时视为单节点
+        if (nodes_.empty() && !allowed.empty())
+        {
+            NumaNode node;
+            node.cpus = allowed;
+            nodes_.push_back(node);
+        }
+#endif
+
+        if (nodes_.empty())
+        {
+            NumaNode node;
+            unsigned count = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned cpu = 0; cpu < count; cpu++)
+            {
+                node.cpus.push_back(static_cast<int>(cpu));
+            }
+            nodes_.push_back(node);
+        }
+
+        for (const NumaNode &node : nodes_)
+        {
+            cpus_.insert(cpus_.end(), node.cpus.begin(), node.cpus.end());
+        }
+    }
+
+    int CpuTopology::NodeOfCpu(int cpu) const
+    {
+        for (size_t i = 0; i < nodes_.size(); i++)
+        {
+            if (std::find(nodes_[i].cpus.begin(), nodes_[i].cpus.end(), cpu) != nodes_[i].cpus.end())
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return 0;
+    }
+
+    bool CpuTopology::PinCurrentThread(const std::vector<int> &cpus)
+    {
+        const CpuTopology &topology = Get();
+        const std::vector<int> &target = cpus.empty() ? topology.Cpus() : cpus;
+
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : target)
+        {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        {
+            return false;
+        }
+
+        // 跨节点的集合按第一个 CPU 所在节点记账
+        currentNode = cpus.empty() ? 0 : topology.NodeOfCpu(target.front());
+        return true;
+#else
+        (void)target;
+        return false;
+#endif
+    }
+
+    int CpuTopology::CurrentNode()
+    {
+        return currentNode;
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
@@ -0,0 +1,41 @@
+#ifndef NAPI_OPENCV_CPU_TOPOLOGY_H
+#define NAPI_OPENCV_CPU_TOPOLOGY_H
+
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    struct NumaNode
+    {
+        int id = 0;
+        std::vector<int> cpus;
+    };
+
+    // 进程可用的 CPU 与 NUMA 节点，Linux 上读取 /sys/devices/system/node，其他平台视为单节点
+    class CpuTopology
+    {
+    public:
+        static const CpuTopology &Get();
+
+        const std::vector<NumaNode> &Nodes() const { return nodes_; }
+        // 按节点顺序排列的全部可用 CPU
+        const std::vector<int> &Cpus() const { return cpus_; }
+        int NodeOfCpu(int cpu) const;
+
+        // 把当前线程绑定到给定的 CPU 集合，空集合表示恢复为全部可用 CPU；平台不支持时返回 false
+        static bool PinCurrentThread(const std::vector<int> &cpus);
+        // 当前线程绑定到的节点序号（Nodes() 中的下标），未绑定的线程为 0
+        static int CurrentNode();
+
+    private:
+        CpuTopology();
+
+        std::vector<NumaNode> nodes_;
+        std::vector<int> cpus_;
+    };
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_CPU_TOPOLOGY_H
@@ -0,0 +1,41 @@
+#ifndef NAPI_OPENCV_DISPOSABLE_H
+#define NAPI_OPENCV_DISPOSABLE_H
+
+#include <napi.h>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    // 为句柄类的原型安装 [Symbol.dispose]，指向已定义的 release() 方法，支持 TypeScript 的 using 语法
+    // 运行时没有 Symbol.dispose 时使用 Symbol.for("Symbol.dispose")，与 TypeScript 的降级实现一致
+    inline void DefineDispose(Napi::Env env, Napi::Function ctor)
+    {
+        Napi::Object symbolCtor = env.Global().Get("Symbol").As<Napi::Object>();
+        Napi::Value dispose = symbolCtor.Get("dispose");
+        if (!dispose.IsSymbol())
+        {
+            dispose = Napi::Symbol::For(env, "Symbol.dispose");
+        }
+
+        Napi::Object prototype = ctor.Get("prototype").As<Napi::Object>();
+        prototype.Set(dispose, prototype.Get("release"));
+    }
+
+    // release() 返回 Promise 的句柄另外安装 [Symbol.asyncDispose]，支持 await using
+    inline void DefineAsyncDispose(Napi::Env env, Napi::Function ctor)
+    {
+        Napi::Object symbolCtor = env.Global().Get("Symbol").As<Napi::Object>();
+        Napi::Value asyncDispose = symbolCtor.Get("asyncDispose");
+        if (!asyncDispose.IsSymbol())
+        {
+            asyncDispose = Napi::Symbol::For(env, "Symbol.asyncDispose");
+        }
+
+        Napi::Object prototype = ctor.Get("prototype").As<Napi::Object>();
+        prototype.Set(asyncDispose, prototype.Get("release"));
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_DISPOSABLE_H
@@ -0,0 +1,560 @@
+#include "job_scheduler.h"
+#include "addon_data.h"
+#include "cpu_topology.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        thread_local Job *currentJob = nullptr;
+
+        double ElapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+        {
+            return std::chrono::duration<double, std::milli>(to - from).count();
+        }
+    } // namespace
+
+    // ==================== EnvJobQueue ====================
+
+    std::shared_ptr<EnvJobQueue> EnvJobQueue::ForEnv(Napi::Env env)
+    {
+        AddonData *data = GetAddonData(env);
+        if (!data->jobQueue)
+        {
+            data->jobQueue = std::make_shared<EnvJobQueue>(env);
+        }
+        return data->jobQueue;
+    }
+
+    EnvJobQueue::EnvJobQueue(Napi::Env env)
+    {
+        // 队列不设上限：任务数量已由调度器的有界队列限制
+        tsfn_ = Napi::TypedThreadSafeFunction<EnvJobQueue, Job, CallJs>::New(
+            env, "opencv-napi:jobs", 0, 1, this, Finalize, static_cast<void *>(nullptr));
+        // 空闲时不阻止进程退出
+        tsfn_.Unref(env);
+    }
+
+    void EnvJobQueue::BeginJob(Napi::Env env)
+    {
+        if (outstanding_++ == 0)
+        {
+            tsfn_.Ref(env);
+        }
+    }
+
+    void EnvJobQueue::EndJob(Napi::Env env)
+    {
+        if (--outstanding_ == 0)
+        {
+            tsfn_.Unref(env);
+        }
+    }
+
+    void EnvJobQueue::Post(Job *job)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_ || tsfn_.NonBlockingCall(job) != napi_ok)
+        {
+            job->Discard();
+            delete job;
+        }
+    }
+
+    void EnvJobQueue::SignalNotFull()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_ || signalled_)
+        {
+            return;
+        }
+        signalled_ = tsfn_.NonBlockingCall(nullptr) == napi_ok;
+    }
+
+    void EnvJobQueue::CallJs(Napi::Env env, Napi::Function, EnvJobQueue *context, Job *job)
+    {
+        if (job == nullptr)
+        {
+            if (env != nullptr)
+            {
+                JobScheduler::Instance().AdmitWaiting(env, context);
+            }
+            return;
+        }
+
+        if (env == nullptr)
+        {
+            job->Discard();
+            delete job;
+            return;
+        }
+
+        job->Complete(env);
+        delete job;
+        context->EndJob(env);
+    }
+
+    // env 退出时由 Node 调用，之后 Post 不再访问线程安全函数
+    void EnvJobQueue::Finalize(Napi::Env, void *, EnvJobQueue *context)
+    {
+        std::lock_guard<std::mutex> lock(context->mutex_);
+        context->closed_ = true;
+    }
+
+    void EnvJobQueue::ArmTimer(Napi::Env env, std::chrono::steady_clock::time_point deadline)
+    {
+        if (!timer_.IsEmpty())
+        {
+            if (timerDeadline_ == deadline)
+            {
+                return;
+            }
+            env.Global().Get("clearTimeout").As<Napi::Function>().Call({timer_.Value()});
+            timer_.Reset();
+        }
+        if (deadline == std::chrono::steady_clock::time_point::max())
+        {
+            return;
+        }
+
+        // 向上取整到毫秒，定时器不会在截止时间之前触发
+        double delayMs = std::ceil(std::max(0.0, ElapsedMs(std::chrono::steady_clock::now(), deadline)));
+        Napi::Function callback = Napi::Function::New(env, [this](const Napi::CallbackInfo &info)
+                                                      {
+            timer_.Reset();
+            JobScheduler::Instance().AdmitWaiting(info.Env(), this); });
+        Napi::Value timer = env.Global().Get("setTimeout").As<Napi::Function>().Call({callback, Napi::Number::New(env, delayMs)});
+        timer_ = Napi::Persistent(timer.As<Napi::Object>());
+        timerDeadline_ = deadline;
+    }
+
+    // ==================== Job ====================
+
+    bool Job::CurrentCancelled()
+    {
+        return currentJob != nullptr && currentJob->IsCancelled();
+    }
+
+    // ==================== JobScheduler ====================
+
+    JobScheduler &JobScheduler::Instance()
+    {
+        // 故意不析构：分离的工作线程在进程退出前一直引用调度器
+        static JobScheduler *instance = new JobScheduler();
+        return *instance;
+    }
+
+    JobScheduler::JobScheduler()
+    {
+        config_.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 'wait' 策略不阻塞 JS 线程：任务进入本 env 的等待队列，由工作线程腾出空位后经线程安全函数通知接纳，
+    // 截止时间由 setTimeout 检查
+    bool JobScheduler::Submit(Napi::Env env, Job *job)
+    {
+        std::shared_ptr<EnvJobQueue> target = EnvJobQueue::ForEnv(env);
+        int lane = static_cast<int>(job->priority_);
+        auto now = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool wait = config_.policy == FullPolicy::Wait && config_.waitTimeoutMs > 0;
+        // 本 env 已有任务在等待时新任务排在其后，保持提交顺序
+        bool full = queues_[lane].size() >= config_.maxQueue || (wait && !target->waiting_[lane].empty());
+        if (full && !wait)
+        {
+            stats_.rejected++;
+            return false;
+        }
+
+        job->target_ = target;
+        job->enqueuedAt_ = now;
+        target->BeginJob(env);
+
+        if (!full)
+        {
+            EnqueueLocked(job);
+            return true;
+        }
+
+        auto deadline = now + std::chrono::milliseconds(config_.waitTimeoutMs);
+        target->waiting_[lane].push_back({job, deadline});
+        stats_.waiting++;
+        stats_.lanes[lane].waiting++;
+        if (std::find(waitingEnvs_.begin(), waitingEnvs_.end(), target) == waitingEnvs_.end())
+        {
+            waitingEnvs_.push_back(target);
+        }
+        // 只因前面还有等待的任务而排队时，空位已经存在，不必等工作线程通知
+        if (queues_[lane].size() < config_.maxQueue)
+        {
+            target->SignalNotFull();
+        }
+        lock.unlock();
+
+        // 已有定时器时它对准的是更早的截止时间
+        if (target->timer_.IsEmpty())
+        {
+            target->ArmTimer(env, deadline);
+        }
+        return true;
+    }
+
+    bool JobScheduler::Remove(Napi::Env env, Job *job)
+    {
+        int lane = static_cast<int>(job->priority_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::deque<Job *> &queue = queues_[lane];
+        auto it = std::find(queue.begin(), queue.end(), job);
+        if (it != queue.end())
+        {
+            queue.erase(it);
+            NotifyNotFullLocked();
+        }
+        else
+        {
+            if (!job->target_)
+            {
+                return false;
+            }
+            std::deque<EnvJobQueue::WaitingJob> &waiting = job->target_->waiting_[lane];
+            auto waitingIt = std::find_if(waiting.begin(), waiting.end(), [job](const EnvJobQueue::WaitingJob &entry)
+                                          { return entry.job == job; });
+            if (waitingIt == waiting.end())
+            {
+                return false;
+            }
+            waiting.erase(waitingIt);
+            stats_.waiting--;
+            stats_.lanes[lane].waiting--;
+        }
+
+        stats_.cancelled++;
+        job->target_->EndJob(env);
+        job->target_.reset();
+        return true;
+    }
+
+    void JobScheduler::AdmitWaiting(Napi::Env env, EnvJobQueue *target)
+    {
+        {
+            std::lock_guard<std::mutex> lock(target->mutex_);
+            target->signalled_ = false;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto nextDeadline = std::chrono::steady_clock::time_point::max();
+        std::vector<Job *> expired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (int lane = 0; lane < 2; lane++)
+            {
+                std::deque<EnvJobQueue::WaitingJob> &waiting = target->waiting_[lane];
+                while (!waiting.empty() && queues_[lane].size() < config_.maxQueue)
+                {
+                    EnqueueLocked(waiting.front().job);
+                    waiting.pop_front();
+                    stats_.waiting--;
+                    stats_.lanes[lane].waiting--;
+                }
+
+                for (auto it = waiting.begin(); it != waiting.end();)
+                {
+                    if (it->deadline > now)
+                    {
+                        nextDeadline = std::min(nextDeadline, it->deadline);
+                        ++it;
+                        continue;
+                    }
+                    expired.push_back(it->job);
+                    it = waiting.erase(it);
+                    stats_.waiting--;
+                    stats_.lanes[lane].waiting--;
+                    stats_.rejected++;
+                }
+            }
+
+            if (target->waiting_[0].empty() && target->waiting_[1].empty())
+            {
+                waitingEnvs_.erase(std::remove_if(waitingEnvs_.begin(), waitingEnvs_.end(),
+                                                  [target](const std::shared_ptr<EnvJobQueue> &queue)
+                                                  { return queue.get() == target; }),
+                                   waitingEnvs_.end());
+            }
+        }
+
+        target->ArmTimer(env, nextDeadline);
+
+        for (Job *job : expired)
+        {
+            job->target_.reset();
+            job->Fail("任务队列已满");
+            job->Complete(env);
+            delete job;
+            target->EndJob(env);
+        }
+    }
+
+    size_t JobScheduler::DropEnv(const std::shared_ptr<EnvJobQueue> &target)
+    {
+        std::vector<Job *> dropped;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (std::deque<Job *> &queue : queues_)
+            {
+                auto it = std::stable_partition(queue.begin(), queue.end(), [&target](Job *job)
+                                                { return job->target_ != target; });
+                dropped.insert(dropped.end(), it, queue.end());
+                queue.erase(it, queue.end());
+            }
+            for (int lane = 0; lane < 2; lane++)
+            {
+                for (const EnvJobQueue::WaitingJob &entry : target->waiting_[lane])
+                {
+                    dropped.push_back(entry.job);
+                }
+                stats_.waiting -= target->waiting_[lane].size();
+                stats_.lanes[lane].waiting -= target->waiting_[lane].size();
+                target->waiting_[lane].clear();
+            }
+            waitingEnvs_.erase(std::remove(waitingEnvs_.begin(), waitingEnvs_.end(), target), waitingEnvs_.end());
+            stats_.cancelled += dropped.size();
+
+            for (Job *job : running_)
+            {
+                if (job->target_ == target)
+                {
+                    job->Cancel();
+                }
+            }
+            NotifyNotFullLocked();
+
+            // 单阶段任务不检查取消标记，仍在读取 fromBuffer 借用的内存，须等它们结束后 env 才能释放这些内存
+            jobDone_.wait(lock, [this, &target]()
+                          { return std::none_of(running_.begin(), running_.end(), [&target](Job *job)
+                                                { return job->target_ == target; }); });
+        }
+
+        // 定时器不会再触发，引用须在 env 销毁前释放
+        target->timer_.Reset();
+
+        // env 正在退出，Promise 无法再结算
+        for (Job *job : dropped)
+        {
+            job->target_.reset();
+            job->Discard();
+            delete job;
+        }
+        return dropped.size();
+    }
+
+    void JobScheduler::Configure(const Config &config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (config.affinity != config_.affinity)
+        {
+            affinityGeneration_++;
+        }
+        config_ = config;
+        if (config_.workers < 1)
+        {
+            config_.workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        config_.reservedWorkers = std::max(0, std::min(config_.reservedWorkers, config_.workers - 1));
+        config_.interactiveWeight = std::max(1, config_.interactiveWeight);
+
+        // 序号超出 workers 的线程在取下一个任务前自行退出
+        if (activeWorkers_ > 0)
+        {
+            EnsureWorkersLocked();
+        }
+        notEmpty_.notify_all();
+        NotifyNotFullLocked();
+    }
+
+    JobScheduler::Config JobScheduler::GetConfig()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return config_;
+    }
+
+    JobScheduler::Stats JobScheduler::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.workers = config_.workers;
+        for (int lane = 0; lane < 2; lane++)
+        {
+            stats.lanes[lane].queueDepth = queues_[lane].size();
+            stats.queueDepth += queues_[lane].size();
+        }
+        return stats;
+    }
+
+    int JobScheduler::BulkSlotsLocked() const
+    {
+        return config_.workers - config_.reservedWorkers;
+    }
+
+    bool JobScheduler::HasRunnableLocked() const
+    {
+        const int bulk = static_cast<int>(JobPriority::Bulk);
+        return !queues_[static_cast<int>(JobPriority::Interactive)].empty() ||
+               (!queues_[bulk].empty() && static_cast<int>(stats_.lanes[bulk].running) < BulkSlotsLocked());
+    }
+
+    // 交互式任务优先；两个通道都有可运行的任务时按 interactiveWeight 轮流出队，避免批量任务饿死
+    Job *JobScheduler::PopNextLocked()
+    {
+        std::deque<Job *> &interactive = queues_[static_cast<int>(JobPriority::Interactive)];
+        std::deque<Job *> &bulk = queues_[static_cast<int>(JobPriority::Bulk)];
+        bool bulkRunnable = !bulk.empty() &&
+                            static_cast<int>(stats_.lanes[static_cast<int>(JobPriority::Bulk)].running) < BulkSlotsLocked();
+
+        std::deque<Job *> &queue = !interactive.empty() && (!bulkRunnable || interactiveStreak_ < config_.interactiveWeight)
+                                       ? interactive
+                                       : bulk;
+        if (&queue == &bulk)
+        {
+            interactiveStreak_ = 0;
+        }
+        else if (bulkRunnable)
+        {
+            interactiveStreak_++;
+        }
+
+        Job *job = queue.front();
+        queue.pop_front();
+        return job;
+    }
+
+    void JobScheduler::EnqueueLocked(Job *job)
+    {
+        int lane = static_cast<int>(job->priority_);
+        queues_[lane].push_back(job);
+        stats_.submitted++;
+        stats_.lanes[lane].submitted++;
+        EnsureWorkersLocked();
+        notEmpty_.notify_one();
+    }
+
+    void JobScheduler::NotifyNotFullLocked()
+    {
+        for (const std::shared_ptr<EnvJobQueue> &target : waitingEnvs_)
+        {
+            target->SignalNotFull();
+        }
+    }
+
+    // 线程按需创建，首次提交任务前不占用任何线程
+    void JobScheduler::EnsureWorkersLocked()
+    {
+        if (workerSlots_.size() < static_cast<size_t>(config_.workers))
+        {
+            workerSlots_.resize(config_.workers, false);
+        }
+        for (int index = 0; index < config_.workers; index++)
+        {
+            if (!workerSlots_[index])
+            {
+                workerSlots_[index] = true;
+                activeWorkers_++;
+                std::thread(&JobScheduler::WorkerLoop, this, index).detach();
+            }
+        }
+    }
+
+    std::vector<int> JobScheduler::AffinityCpusLocked(int index) const
+    {
+        const CpuTopology &topology = CpuTopology::Get();
+        switch (config_.affinity)
+        {
+        case Affinity::Core:
+            return {topology.Cpus()[index % topology.Cpus().size()]};
+        case Affinity::Node:
+            return topology.Nodes()[index % topology.Nodes().size()].cpus;
+        default:
+            return {};
+        }
+    }
+
+    void JobScheduler::WorkerLoop(int index)
+    {
+        // 新线程未绑定，相当于已应用第 0 代的 None
+        uint64_t pinnedGeneration = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            notEmpty_.wait(lock, [this, index]()
+                           { return HasRunnableLocked() || index >= config_.workers; });
+            if (index >= config_.workers)
+            {
+                workerSlots_[index] = false;
+                activeWorkers_--;
+                return;
+            }
+
+            if (pinnedGeneration != affinityGeneration_)
+            {
+                pinnedGeneration = affinityGeneration_;
+                std::vector<int> cpus = AffinityCpusLocked(index);
+                lock.unlock();
+                CpuTopology::PinCurrentThread(cpus);
+                lock.lock();
+                continue;
+            }
+
+            Job *job = PopNextLocked();
+            LaneStats &lane = stats_.lanes[static_cast<int>(job->priority_)];
+            stats_.running++;
+            lane.running++;
+            running_.push_back(job);
+            NotifyNotFullLocked();
+
+            auto startedAt = std::chrono::steady_clock::now();
+            double waitMs = ElapsedMs(job->enqueuedAt_, startedAt);
+            int threads = job->threads_ > 0 ? job->threads_ : config_.threadsPerJob;
+            lock.unlock();
+
+            // 已在运行前被取消的任务跳过执行，直接送回 JS 线程拒绝；Job::Execute 自行捕获异常
+            if (!job->IsCancelled())
+            {
+                BudgetParallelBackend::BudgetScope budget(threads);
+                currentJob = job;
+                job->Execute();
+                currentJob = nullptr;
+            }
+
+            auto finishedAt = std::chrono::steady_clock::now();
+            double runMs = ElapsedMs(startedAt, finishedAt);
+
+            // 投递之后任务可能随时在 JS 线程被删除，先从运行列表中移除
+            lock.lock();
+            running_.erase(std::find(running_.begin(), running_.end(), job));
+            std::shared_ptr<EnvJobQueue> target = std::move(job->target_);
+            stats_.running--;
+            stats_.completed++;
+            stats_.totalWaitMs += waitMs;
+            stats_.maxWaitMs = std::max(stats_.maxWaitMs, waitMs);
+            lane.running--;
+            lane.completed++;
+            lane.totalWaitMs += waitMs;
+            lane.maxWaitMs = std::max(lane.maxWaitMs, waitMs);
+            stats_.totalRunMs += runMs;
+            stats_.maxRunMs = std::max(stats_.maxRunMs, runMs);
+            jobDone_.notify_all();
+            lock.unlock();
+
+            target->Post(job);
+            lock.lock();
+        }
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
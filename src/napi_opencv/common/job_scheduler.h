@@ -0,0 +1,232 @@
+#ifndef NAPI_OPENCV_JOB_SCHEDULER_H
+#define NAPI_OPENCV_JOB_SCHEDULER_H
+
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    class EnvJobQueue;
+
+    // 任务的优先级通道：交互式任务（预览等延迟敏感请求）优先于批量任务出队
+    enum class JobPriority
+    {
+        Interactive = 0,
+        Bulk = 1
+    };
+
+    // 调度器中的一个任务：Execute 在工作线程执行，Complete 回到提交它的 env 的 JS 线程执行
+    class Job
+    {
+    public:
+        virtual ~Job() = default;
+
+        virtual void Execute() = 0;
+        virtual void Complete(Napi::Env env) = 0;
+        // env 已经销毁时调用，不能再访问任何 JS 值
+        virtual void Discard() = 0;
+        // 未执行就失败（如等待空位超时），随后由 Complete 以 message 拒绝
+        virtual void Fail(const std::string &message) = 0;
+
+        // 本任务内 OpenCV 并行区域可用的线程数，0 表示使用调度器的 threadsPerJob
+        void SetThreads(int threads) { threads_ = threads; }
+        // 只能在提交前设置
+        void SetPriority(JobPriority priority) { priority_ = priority; }
+
+        // 请求取消：运行中的任务在阶段之间检查该标记，结果在完成时被丢弃
+        void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+        bool IsCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+        // 当前工作线程正在执行的任务是否已被取消，不在任务中时返回 false
+        static bool CurrentCancelled();
+
+    private:
+        friend class JobScheduler;
+
+        int threads_ = 0;
+        JobPriority priority_ = JobPriority::Interactive;
+        std::atomic<bool> cancelled_{false};
+        std::shared_ptr<EnvJobQueue> target_;
+        std::chrono::steady_clock::time_point enqueuedAt_;
+    };
+
+    // 每个 env 一份：通过线程安全函数把完成的任务送回 JS 线程，有未完成任务时保持事件循环存活
+    class EnvJobQueue
+    {
+    public:
+        // 取得当前 env 的队列，首次调用时创建
+        static std::shared_ptr<EnvJobQueue> ForEnv(Napi::Env env);
+
+        explicit EnvJobQueue(Napi::Env env);
+
+        // 以下两个方法只能在 JS 线程调用
+        void BeginJob(Napi::Env env);
+        void EndJob(Napi::Env env);
+
+        // 工作线程调用；env 已关闭时直接丢弃任务
+        void Post(Job *job);
+
+        // 调度器的通道出现空位时调用，通知 JS 线程接纳本 env 等待中的任务；已有通知在途时不重复发送
+        void SignalNotFull();
+
+    private:
+        friend class JobScheduler;
+
+        struct WaitingJob
+        {
+            Job *job;
+            std::chrono::steady_clock::time_point deadline;
+        };
+
+        // job 为空时表示空位通知
+        static void CallJs(Napi::Env env, Napi::Function callback, EnvJobQueue *context, Job *job);
+        static void Finalize(Napi::Env env, void *data, EnvJobQueue *context);
+
+        // 在 JS 线程调用：把超时定时器对准 deadline，time_point::max() 表示取消
+        void ArmTimer(Napi::Env env, std::chrono::steady_clock::time_point deadline);
+
+        Napi::TypedThreadSafeFunction<EnvJobQueue, Job, CallJs> tsfn_;
+        std::mutex mutex_;
+        bool closed_ = false;
+        bool signalled_ = false;
+        size_t outstanding_ = 0;
+
+        // 'wait' 策略下等待空位的任务，按 JobPriority 索引，先进先出；由调度器的锁保护
+        std::deque<WaitingJob> waiting_[2];
+        // 最早截止时间的 setTimeout 句柄，只在 JS 线程访问
+        Napi::ObjectReference timer_;
+        std::chrono::steady_clock::time_point timerDeadline_;
+    };
+
+    // 插件自有的图像任务工作线程池，与 libuv 线程池（fs、DNS 等）分开，队列有上限
+    class JobScheduler
+    {
+    public:
+        enum class FullPolicy
+        {
+            Reject, // 队列已满时立即拒绝
+            Wait    // 立即返回 Promise，任务在本 env 中排队等待空位，超过 waitTimeoutMs 后拒绝
+        };
+
+        // 工作线程的 CPU 绑定方式
+        enum class Affinity
+        {
+            None, // 不绑定，由系统调度
+            Core, // 第 i 个工作线程绑定到按节点顺序排列的第 i 个 CPU
+            Node  // 工作线程轮流绑定到各 NUMA 节点的全部 CPU
+        };
+
+        struct Config
+        {
+            int workers = 0;
+            // 每个优先级通道各自的队列上限，批量任务排满不影响交互式任务入队
+            size_t maxQueue = 1024;
+            FullPolicy policy = FullPolicy::Reject;
+            int64_t waitTimeoutMs = 1000;
+            // 每个任务的线程预算：1 适合批量吞吐，较少的 workers 配合较大的值适合降低单个任务延迟
+            int threadsPerJob = 1;
+            // 只执行交互式任务的工作线程数，最多为 workers - 1，保证批量任务总能推进
+            int reservedWorkers = 0;
+            // 两个通道都有任务时，每执行一个批量任务之前最多连续执行的交互式任务数
+            int interactiveWeight = 4;
+            // 只绑定工作线程，任务内 parallel_for_ 的辅助线程不绑定
+            Affinity affinity = Affinity::None;
+        };
+
+        struct LaneStats
+        {
+            size_t queueDepth = 0;
+            // 'wait' 策略下尚未入队、等待空位的任务数
+            size_t waiting = 0;
+            size_t running = 0;
+            uint64_t submitted = 0;
+            uint64_t completed = 0;
+            double totalWaitMs = 0;
+            double maxWaitMs = 0;
+        };
+
+        struct Stats
+        {
+            int workers = 0;
+            size_t queueDepth = 0;
+            size_t waiting = 0;
+            size_t running = 0;
+            uint64_t submitted = 0;
+            uint64_t completed = 0;
+            uint64_t rejected = 0;
+            uint64_t cancelled = 0;
+            double totalWaitMs = 0;
+            double maxWaitMs = 0;
+            double totalRunMs = 0;
+            double maxRunMs = 0;
+            // 按 JobPriority 索引
+            LaneStats lanes[2];
+        };
+
+        static JobScheduler &Instance();
+
+        // 在 JS 线程提交，不会阻塞；队列已满且策略为 'reject' 时返回 false，任务仍归调用方所有
+        bool Submit(Napi::Env env, Job *job);
+
+        // 在 JS 线程调用：任务仍在队列中或仍在等待空位时移出并返回 true，任务重新归调用方所有
+        bool Remove(Napi::Env env, Job *job);
+
+        // 在 target 的 JS 线程调用：把等待中的任务按先进先出移入有空位的通道，拒绝已超过截止时间的任务
+        void AdmitWaiting(Napi::Env env, EnvJobQueue *target);
+
+        // env 退出时在其 JS 线程调用：丢弃该 env 仍在队列中或等待空位的任务，运行中的任务标记为取消，
+        // 并等待它们执行完毕，之后任务借用的 JS 内存可以安全释放；返回丢弃的数量
+        size_t DropEnv(const std::shared_ptr<EnvJobQueue> &target);
+
+        void Configure(const Config &config);
+        Config GetConfig();
+        Stats GetStats();
+
+    private:
+        JobScheduler();
+
+        void EnqueueLocked(Job *job);
+        // 通道出现空位时调用，通知有任务在等待的 env
+        void NotifyNotFullLocked();
+        void EnsureWorkersLocked();
+        void WorkerLoop(int index);
+        std::vector<int> AffinityCpusLocked(int index) const;
+        // 批量任务最多同时占用的工作线程数
+        int BulkSlotsLocked() const;
+        bool HasRunnableLocked() const;
+        Job *PopNextLocked();
+
+        std::mutex mutex_;
+        std::condition_variable notEmpty_;
+        // 任务离开 running_ 时通知，供 DropEnv 等待
+        std::condition_variable jobDone_;
+        // 按 JobPriority 索引
+        std::deque<Job *> queues_[2];
+        // 有任务在等待空位的 env
+        std::vector<std::shared_ptr<EnvJobQueue>> waitingEnvs_;
+        // 正在工作线程中执行的任务，供 DropEnv 取消
+        std::vector<Job *> running_;
+        Config config_;
+        Stats stats_;
+        int activeWorkers_ = 0;
+        // 按序号记录工作线程是否存在：收缩时序号最大的线程退出，扩容时补齐空出的序号，绑定的 CPU 不重复
+        std::vector<bool> workerSlots_;
+        // 两个通道都有任务时已连续出队的交互式任务数
+        int interactiveStreak_ = 0;
+        // 每次修改 affinity 时递增，工作线程据此在取下一个任务前重新绑定
+        uint64_t affinityGeneration_ = 0;
+    };
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_JOB_SCHEDULER_H
@@ -0,0 +1,985 @@
+#include "mat_wrap.h"
+#include "addon_data.h"
+#include "allocator.h"
+#include "disposable.h"
+#include "safe_call.h"
+#include "type_converters.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        std::vector<int> ParseSizes(Napi::Value value)
+        {
+            if (!value.IsArray())
+            {
+                throw std::invalid_argument("期望 sizes 数组");
+            }
+
+            Napi::Array array = value.As<Napi::Array>();
+            if (array.Length() < 1 || array.Length() > CV_MAX_DIM)
+            {
+                throw std::invalid_argument("sizes 维数超出范围");
+            }
+
+            std::vector<int> sizes(array.Length());
+            for (uint32_t i = 0; i < array.Length(); i++)
+            {
+                sizes[i] = array.Get(i).As<Napi::Number>().Int32Value();
+                if (sizes[i] <= 0)
+                {
+                    throw std::invalid_argument("sizes 必须为正数");
+                }
+            }
+            return sizes;
+        }
+
+        std::vector<size_t> ParseSteps(Napi::Value value)
+        {
+            if (!value.IsArray())
+            {
+                throw std::invalid_argument("期望 steps 数组");
+            }
+
+            Napi::Array array = value.As<Napi::Array>();
+            std::vector<size_t> steps(array.Length());
+            for (uint32_t i = 0; i < array.Length(); i++)
+            {
+                steps[i] = static_cast<size_t>(array.Get(i).As<Napi::Number>().Int64Value());
+            }
+            return steps;
+        }
+
+        template <typename T>
+        Napi::Array ToNumberArray(Napi::Env env, const T *values, int count)
+        {
+            Napi::Array array = Napi::Array::New(env, count);
+            for (int i = 0; i < count; i++)
+            {
+                array.Set(static_cast<uint32_t>(i), Napi::Number::New(env, static_cast<double>(values[i])));
+            }
+            return array;
+        }
+
+        // 在外部内存上创建 N 维 Mat 头；steps 为空时按紧密排列计算，可省略最内层步长
+        cv::Mat MakeBorrowedHeader(uint8_t *data, size_t length, const std::vector<int> &sizes,
+                                   int type, std::vector<size_t> steps)
+        {
+            int dims = static_cast<int>(sizes.size());
+            size_t elemSize = CV_ELEM_SIZE(type);
+
+            if (steps.empty())
+            {
+                steps.resize(dims);
+                steps[dims - 1] = elemSize;
+                for (int i = dims - 2; i >= 0; i--)
+                {
+                    steps[i] = steps[i + 1] * sizes[i + 1];
+                }
+            }
+            else if (static_cast<int>(steps.size()) == dims - 1)
+            {
+                steps.push_back(elemSize);
+            }
+
+            if (static_cast<int>(steps.size()) != dims || steps[dims - 1] != elemSize)
+            {
+                throw std::invalid_argument("steps 长度与维数不匹配");
+            }
+
+            size_t span = elemSize;
+            for (int i = 0; i < dims; i++)
+            {
+                if (steps[i] % CV_ELEM_SIZE1(type) != 0 ||
+                    (i < dims - 1 && steps[i] < steps[i + 1] * sizes[i + 1]))
+                {
+                    throw std::invalid_argument("step 小于下一维的字节数或未按元素对齐");
+                }
+                span += static_cast<size_t>(sizes[i] - 1) * steps[i];
+            }
+
+            // 最后一行不要求带有行尾填充
+            if (span > length)
+            {
+                throw std::invalid_argument("Buffer 长度不足以容纳指定的矩阵");
+            }
+
+            return cv::Mat(dims, sizes.data(), type, data, steps.data());
+        }
+
+        // 等待被其他 env 领取的 Mat，按令牌索引；进程内所有 worker 共用
+        // issuer 为发送方 env 的 AddonData，发送方退出时其未被领取的令牌随之失效
+        struct PendingTransfer
+        {
+            cv::Mat mat;
+            const AddonData *issuer;
+        };
+
+        std::mutex transferMutex;
+        std::unordered_map<uint64_t, PendingTransfer> transferRegistry;
+        std::atomic<uint64_t> nextTransferToken{1};
+
+        // owner 为 SharedArrayBuffer 或其上的视图时返回该 SharedArrayBuffer，否则返回空值
+        Napi::Value SharedBufferOf(Napi::Env env, Napi::Value owner)
+        {
+            Napi::Value sabCtor = env.Global().Get("SharedArrayBuffer");
+            if (!owner.IsObject() || !sabCtor.IsFunction())
+            {
+                return Napi::Value();
+            }
+
+            Napi::Function ctor = sabCtor.As<Napi::Function>();
+            Napi::Object object = owner.As<Napi::Object>();
+            if (object.InstanceOf(ctor))
+            {
+                return object;
+            }
+            if (object.IsTypedArray() || object.IsDataView())
+            {
+                Napi::Value buffer = object.Get("buffer");
+                if (buffer.IsObject() && buffer.As<Napi::Object>().InstanceOf(ctor))
+                {
+                    return buffer;
+                }
+            }
+            return Napi::Value();
+        }
+
+        // 通过 Uint8Array 视图取得 SharedArrayBuffer 的地址，Node-API 不直接提供该接口
+        void SharedBytes(Napi::Env env, Napi::Value sab, uint8_t *&data, size_t &length)
+        {
+            Napi::Function uint8Ctor = env.Global().Get("Uint8Array").As<Napi::Function>();
+            if (!MatWrap::GetBytes(env, uint8Ctor.New({sab}), data, length))
+            {
+                throw std::runtime_error("无法访问 SharedArrayBuffer 内存");
+            }
+        }
+    } // namespace
+
+    template <Napi::Value (MatWrap::*Method)(const Napi::CallbackInfo &)>
+    Napi::Value MatWrap::Checked(const Napi::CallbackInfo &info)
+    {
+        if (released_)
+        {
+            Napi::Error::New(info.Env(), "Mat 已释放").ThrowAsJavaScriptException();
+            return info.Env().Undefined();
+        }
+        return (this->*Method)(info);
+    }
+
+    void MatWrap::Init(Napi::Env env, Napi::Object exports)
+    {
+        Napi::Function func = DefineClass(env, "Mat", {
+            InstanceAccessor("rows", &MatWrap::Checked<&MatWrap::GetRows>, nullptr),
+            InstanceAccessor("cols", &MatWrap::Checked<&MatWrap::GetCols>, nullptr),
+            InstanceAccessor("channels", &MatWrap::Checked<&MatWrap::GetChannels>, nullptr),
+            InstanceAccessor("type", &MatWrap::Checked<&MatWrap::GetType>, nullptr),
+            InstanceAccessor("depth", &MatWrap::Checked<&MatWrap::GetDepth>, nullptr),
+            InstanceAccessor("dims", &MatWrap::Checked<&MatWrap::GetDims>, nullptr),
+            InstanceAccessor("empty", &MatWrap::Checked<&MatWrap::GetEmpty>, nullptr),
+            InstanceAccessor("elemSize", &MatWrap::Checked<&MatWrap::GetElemSize>, nullptr),
+            InstanceAccessor("step", &MatWrap::Checked<&MatWrap::GetStep>, nullptr),
+            InstanceAccessor("sizes", &MatWrap::Checked<&MatWrap::GetSizes>, nullptr),
+            InstanceAccessor("steps", &MatWrap::Checked<&MatWrap::GetSteps>, nullptr),
+            InstanceAccessor("total", &MatWrap::Checked<&MatWrap::GetTotal>, nullptr),
+            InstanceAccessor("isContinuous", &MatWrap::Checked<&MatWrap::GetIsContinuous>, nullptr),
+            InstanceAccessor("isSubmatrix", &MatWrap::Checked<&MatWrap::GetIsSubmatrix>, nullptr),
+            InstanceAccessor("isReleased", &MatWrap::GetIsReleased, nullptr),
+            InstanceAccessor("isShared", &MatWrap::Checked<&MatWrap::GetIsShared>, nullptr),
+            InstanceAccessor("data", &MatWrap::Checked<&MatWrap::GetTypedData>, nullptr),
+            InstanceMethod("getData", &MatWrap::Checked<&MatWrap::GetData>),
+            InstanceMethod("clone", &MatWrap::Checked<&MatWrap::Clone>),
+            InstanceMethod("toContinuous", &MatWrap::Checked<&MatWrap::ToContinuous>),
+            InstanceMethod("roi", &MatWrap::Checked<&MatWrap::Roi>),
+            InstanceMethod("reshape", &MatWrap::Checked<&MatWrap::Reshape>),
+            InstanceMethod("rowRange", &MatWrap::Checked<&MatWrap::RowRange>),
+            InstanceMethod("colRange", &MatWrap::Checked<&MatWrap::ColRange>),
+            InstanceMethod("locateROI", &MatWrap::Checked<&MatWrap::LocateROI>),
+            InstanceMethod("toObject", &MatWrap::Checked<&MatWrap::ToObject>),
+            InstanceMethod("release", &MatWrap::Release),
+            InstanceMethod("toShared", &MatWrap::Checked<&MatWrap::ToShared>),
+            InstanceMethod("transfer", &MatWrap::Checked<&MatWrap::Transfer>),
+            StaticMethod("fromObject", &MatWrap::FromObject),
+            StaticMethod("fromBuffer", &MatWrap::FromBuffer),
+            StaticMethod("createShared", &MatWrap::CreateShared),
+            StaticMethod("adopt", &MatWrap::Adopt),
+            StaticMethod("pendingTransfers", &MatWrap::PendingTransfers),
+            StaticMethod("fromShared", &MatWrap::FromShared),
+        });
+
+        DefineDispose(env, func);
+
+        GetAddonData(env)->matConstructor = Napi::Persistent(func);
+
+        exports.Set("Mat", func);
+    }
+
+    Napi::Object MatWrap::NewInstance(Napi::Env env, const cv::Mat &mat)
+    {
+        // 只复制 Mat 头，像素数据通过 cv::Mat 引用计数共享
+        cv::Mat header = mat;
+        return GetAddonData(env)->matConstructor.New({Napi::External<cv::Mat>::New(env, &header)});
+    }
+
+    Napi::Object MatWrap::NewInstance(Napi::Env env, const cv::Mat &mat, Napi::Value owner)
+    {
+        Napi::Object instance = NewInstance(env, mat);
+        if (!instance.IsEmpty() && owner.IsObject())
+        {
+            Unwrap(instance)->owner_ = Napi::Persistent(owner.As<Napi::Object>());
+        }
+        return instance;
+    }
+
+    bool MatWrap::IsInstance(Napi::Value value)
+    {
+        return value.IsObject() &&
+               value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env())->matConstructor.Value());
+    }
+
+    MatWrap *MatWrap::FromValue(Napi::Value value)
+    {
+        if (!IsInstance(value))
+        {
+            return nullptr;
+        }
+        return Napi::ObjectWrap<MatWrap>::Unwrap(value.As<Napi::Object>());
+    }
+
+    MatWrap::MatWrap(const Napi::CallbackInfo &info) : Napi::ObjectWrap<MatWrap>(info)
+    {
+        Napi::Env env = info.Env();
+
+        // 内部构造路径：NewInstance 传入 External<cv::Mat>
+        if (info.Length() == 1 && info[0].IsExternal())
+        {
+            mat_ = *info[0].As<Napi::External<cv::Mat>>().Data();
+            NodeMatAllocator::Instance()->Attach(env, mat_);
+            return;
+        }
+
+        // new Mat() 创建空矩阵
+        if (info.Length() == 0)
+        {
+            return;
+        }
+
+        mat_.allocator = NodeMatAllocator::Instance();
+
+        try
+        {
+            // new Mat(sizes[], type[, scalar]) 创建 N 维矩阵
+            if (info[0].IsArray())
+            {
+                if (info.Length() < 2 || !info[1].IsNumber())
+                {
+                    Napi::TypeError::New(env, "期望 (sizes, type[, scalar]) 参数").ThrowAsJavaScriptException();
+                    return;
+                }
+
+                std::vector<int> sizes = ParseSizes(info[0]);
+                int type = info[1].As<Napi::Number>().Int32Value();
+                mat_.create(static_cast<int>(sizes.size()), sizes.data(), type);
+                if (info.Length() > 2 && !info[2].IsUndefined())
+                {
+                    mat_ = TypeConverter<cv::Scalar>::FromNapi(info[2]);
+                }
+                NodeMatAllocator::Instance()->Attach(env, mat_);
+                return;
+            }
+
+            if (info.Length() < 3 || !info[0].IsNumber() || !info[1].IsNumber() || !info[2].IsNumber())
+            {
+                Napi::TypeError::New(env, "期望 (rows, cols, type[, scalar]) 参数").ThrowAsJavaScriptException();
+                return;
+            }
+
+            int rows = info[0].As<Napi::Number>().Int32Value();
+            int cols = info[1].As<Napi::Number>().Int32Value();
+            int type = info[2].As<Napi::Number>().Int32Value();
+
+            if (info.Length() > 3 && !info[3].IsUndefined())
+            {
+                mat_.create(rows, cols, type);
+                mat_ = TypeConverter<cv::Scalar>::FromNapi(info[3]);
+            }
+            else
+            {
+                mat_.create(rows, cols, type);
+            }
+            NodeMatAllocator::Instance()->Attach(env, mat_);
+        }
+        catch (const cv::Exception &e)
+        {
+            Napi::Error::New(env, "OpenCV 错误: " + std::string(e.what())).ThrowAsJavaScriptException();
+        }
+        catch (const std::exception &e)
+        {
+            Napi::Error::New(env, "错误: " + std::string(e.what())).ThrowAsJavaScriptException();
+        }
+    }
+
+    MatWrap::~MatWrap()
+    {
+        // 先释放像素再汇报，GC 回收句柄时 V8 能立即看到外部内存减少
+        mat_.release();
+        NodeMatAllocator::Instance()->FlushExternalMemory(Env());
+    }
+
+    // ==================== 普通对象转换 ====================
+
+    Napi::Object MatWrap::ToPlainObject(Napi::Env env, const cv::Mat &mat, Napi::Value owner)
+    {
+        Napi::Object matObj = Napi::Object::New(env);
+
+        matObj.Set("rows", Napi::Number::New(env, mat.rows));
+        matObj.Set("cols", Napi::Number::New(env, mat.cols));
+        matObj.Set("channels", Napi::Number::New(env, mat.channels()));
+        matObj.Set("type", Napi::Number::New(env, mat.type()));
+        matObj.Set("depth", Napi::Number::New(env, mat.depth()));
+        matObj.Set("dims", Napi::Number::New(env, mat.dims));
+        matObj.Set("empty", Napi::Boolean::New(env, mat.empty()));
+        matObj.Set("elemSize", Napi::Number::New(env, mat.elemSize()));
+        matObj.Set("step", Napi::Number::New(env, mat.step[0]));
+        matObj.Set("sizes", ToNumberArray(env, mat.size.p, mat.dims));
+        matObj.Set("steps", ToNumberArray(env, mat.step.p, mat.dims));
+        matObj.Set("isContinuous", Napi::Boolean::New(env, mat.isContinuous()));
+
+        // data 从 mat.data 开始并保留原始 step，ROI 不会被复制为连续内存
+        if (!mat.empty())
+        {
+            matObj.Set("data", ExportBuffer(env, mat, owner));
+        }
+
+        return matObj;
+    }
+
+    cv::Mat MatWrap::FromPlainObject(Napi::Object matObj)
+    {
+        int type = matObj.Get("type").As<Napi::Number>().Int32Value();
+
+        // 优先使用 N 维的 sizes/steps，旧格式退回 rows/cols/step
+        std::vector<int> sizes;
+        std::vector<size_t> steps;
+        if (matObj.Has("sizes") && matObj.Get("sizes").IsArray())
+        {
+            sizes = ParseSizes(matObj.Get("sizes"));
+            if (matObj.Has("steps") && matObj.Get("steps").IsArray())
+            {
+                steps = ParseSteps(matObj.Get("steps"));
+            }
+        }
+        else
+        {
+            sizes = {matObj.Get("rows").As<Napi::Number>().Int32Value(),
+                     matObj.Get("cols").As<Napi::Number>().Int32Value()};
+            if (matObj.Has("step") && matObj.Get("step").IsNumber())
+            {
+                steps = {static_cast<size_t>(matObj.Get("step").As<Napi::Number>().Int64Value())};
+            }
+        }
+
+        if (!matObj.Has("data"))
+        {
+            return cv::Mat(static_cast<int>(sizes.size()), sizes.data(), type);
+        }
+
+        Napi::Buffer<uint8_t> buffer = matObj.Get("data").As<Napi::Buffer<uint8_t>>();
+        cv::Mat header = MakeBorrowedHeader(buffer.Data(), buffer.Length(), sizes, type, steps);
+        return CloneMat(header);
+    }
+
+    size_t MatWrap::SpanBytes(const cv::Mat &mat)
+    {
+        if (mat.empty())
+        {
+            return 0;
+        }
+
+        size_t span = mat.elemSize();
+        for (int i = 0; i < mat.dims; i++)
+        {
+            span += static_cast<size_t>(mat.size[i] - 1) * mat.step[i];
+        }
+        return span;
+    }
+
+    Napi::Buffer<uint8_t> MatWrap::ExportBuffer(Napi::Env env, const cv::Mat &mat, Napi::Value owner)
+    {
+        if (mat.empty())
+        {
+            return Napi::Buffer<uint8_t>::New(env, 0);
+        }
+
+        // 堆上的 Mat 头持有一份引用计数，Buffer 被回收前像素内存不会释放；
+        // 借用 JS 内存的 Mat 没有 UMatData，由同一个终结器参数固定所属对象
+        ExportHold *hold = new ExportHold{mat, Napi::ObjectReference()};
+        if (owner.IsObject())
+        {
+            hold->owner = Napi::Persistent(owner.As<Napi::Object>());
+        }
+        size_t dataSize = SpanBytes(mat);
+
+        // 运行时禁止外部 Buffer 时 NewOrCopy 会退化为复制，并立即调用终结器
+        return Napi::Buffer<uint8_t>::NewOrCopy(
+            env, hold->mat.data, dataSize,
+            [](Napi::Env env, uint8_t *, ExportHold *hint)
+            {
+                delete hint;
+                NodeMatAllocator::Instance()->FlushExternalMemory(env);
+            },
+            hold);
+    }
+
+    Napi::Value MatWrap::ExportTypedArray(Napi::Env env, const cv::Mat &mat, Napi::Value owner)
+    {
+        Napi::Buffer<uint8_t> buffer = ExportBuffer(env, mat, owner);
+        Napi::ArrayBuffer arrayBuffer = buffer.ArrayBuffer();
+        size_t offset = buffer.ByteOffset();
+        size_t elemSize1 = mat.empty() ? 1 : mat.elemSize1();
+
+        // 视图的字节偏移必须按元素对齐；退化为复制的 Buffer 可能不满足，此时单独复制一份
+        if (offset % elemSize1 != 0)
+        {
+            Napi::ArrayBuffer aligned = Napi::ArrayBuffer::New(env, buffer.Length());
+            std::copy(buffer.Data(), buffer.Data() + buffer.Length(), static_cast<uint8_t *>(aligned.Data()));
+            arrayBuffer = aligned;
+            offset = 0;
+        }
+
+        size_t count = buffer.Length() / elemSize1;
+        switch (mat.depth())
+        {
+        case CV_8S:
+            return Napi::TypedArrayOf<int8_t>::New(env, count, arrayBuffer, offset);
+        case CV_16U:
+            return Napi::TypedArrayOf<uint16_t>::New(env, count, arrayBuffer, offset);
+        case CV_16S:
+            return Napi::TypedArrayOf<int16_t>::New(env, count, arrayBuffer, offset);
+        case CV_32S:
+            return Napi::TypedArrayOf<int32_t>::New(env, count, arrayBuffer, offset);
+        case CV_32F:
+            return Napi::TypedArrayOf<float>::New(env, count, arrayBuffer, offset);
+        case CV_64F:
+            return Napi::TypedArrayOf<double>::New(env, count, arrayBuffer, offset);
+        case CV_16F:
+        {
+            // Node-API 没有 Float16Array 类型，运行时提供全局构造函数时通过 JS 构造，否则返回原始位的 Uint16Array
+            Napi::Value float16Ctor = env.Global().Get("Float16Array");
+            if (float16Ctor.IsFunction())
+            {
+                return float16Ctor.As<Napi::Function>().New({arrayBuffer,
+                                                             Napi::Number::New(env, static_cast<double>(offset)),
+                                                             Napi::Number::New(env, static_cast<double>(count))});
+            }
+            return Napi::TypedArrayOf<uint16_t>::New(env, count, arrayBuffer, offset);
+        }
+        default:
+            return Napi::TypedArrayOf<uint8_t>::New(env, count, arrayBuffer, offset);
+        }
+    }
+
+    bool MatWrap::GetBytes(Napi::Env env, Napi::Value value, uint8_t *&data, size_t &length)
+    {
+        void *ptr = nullptr;
+
+        // TypedArray 与 DataView 直接取视图地址，SharedArrayBuffer 背后的视图同样适用
+        if (value.IsTypedArray())
+        {
+            napi_typedarray_type type;
+            size_t count = 0;
+            if (napi_get_typedarray_info(env, value, &type, &count, &ptr, nullptr, nullptr) != napi_ok)
+            {
+                return false;
+            }
+            length = value.As<Napi::TypedArray>().ByteLength();
+        }
+        else if (value.IsDataView())
+        {
+            if (napi_get_dataview_info(env, value, &length, &ptr, nullptr, nullptr) != napi_ok)
+            {
+                return false;
+            }
+        }
+        else if (value.IsArrayBuffer())
+        {
+            Napi::ArrayBuffer arrayBuffer = value.As<Napi::ArrayBuffer>();
+            ptr = arrayBuffer.Data();
+            length = arrayBuffer.ByteLength();
+        }
+        else
+        {
+            return false;
+        }
+
+        data = static_cast<uint8_t *>(ptr);
+        return true;
+    }
+
+    // ==================== 属性实现 ====================
+
+    Napi::Value MatWrap::GetRows(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.rows);
+    }
+
+    Napi::Value MatWrap::GetCols(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.cols);
+    }
+
+    Napi::Value MatWrap::GetChannels(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.channels());
+    }
+
+    Napi::Value MatWrap::GetType(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.type());
+    }
+
+    Napi::Value MatWrap::GetDepth(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.depth());
+    }
+
+    Napi::Value MatWrap::GetDims(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.dims);
+    }
+
+    Napi::Value MatWrap::GetEmpty(const Napi::CallbackInfo &info)
+    {
+        return Napi::Boolean::New(info.Env(), mat_.empty());
+    }
+
+    Napi::Value MatWrap::GetElemSize(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.elemSize());
+    }
+
+    Napi::Value MatWrap::GetStep(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), mat_.step[0]);
+    }
+
+    Napi::Value MatWrap::GetSizes(const Napi::CallbackInfo &info)
+    {
+        return ToNumberArray(info.Env(), mat_.size.p, mat_.dims);
+    }
+
+    Napi::Value MatWrap::GetSteps(const Napi::CallbackInfo &info)
+    {
+        return ToNumberArray(info.Env(), mat_.step.p, mat_.dims);
+    }
+
+    Napi::Value MatWrap::GetTotal(const Napi::CallbackInfo &info)
+    {
+        return Napi::Number::New(info.Env(), static_cast<double>(mat_.total()));
+    }
+
+    Napi::Value MatWrap::GetIsReleased(const Napi::CallbackInfo &info)
+    {
+        return Napi::Boolean::New(info.Env(), released_);
+    }
+
+    Napi::Value MatWrap::GetIsShared(const Napi::CallbackInfo &info)
+    {
+        return Napi::Boolean::New(info.Env(), !SharedBufferOf(info.Env(), GetOwner()).IsEmpty());
+    }
+
+    Napi::Value MatWrap::GetIsContinuous(const Napi::CallbackInfo &info)
+    {
+        return Napi::Boolean::New(info.Env(), mat_.isContinuous());
+    }
+
+    Napi::Value MatWrap::GetIsSubmatrix(const Napi::CallbackInfo &info)
+    {
+        return Napi::Boolean::New(info.Env(), mat_.isSubmatrix());
+    }
+
+    // ==================== 方法实现 ====================
+
+    // 立即释放像素内存与借用内存的固定，不必等待 GC；重复调用无副作用
+    Napi::Value MatWrap::Release(const Napi::CallbackInfo &info)
+    {
+        if (!released_)
+        {
+            released_ = true;
+            mat_.release();
+            owner_.Reset();
+            NodeMatAllocator::Instance()->FlushExternalMemory(info.Env());
+        }
+        return info.Env().Undefined();
+    }
+
+    Napi::Object MatWrap::WrapDerived(Napi::Env env, const cv::Mat &mat)
+    {
+        if (owner_.IsEmpty())
+        {
+            return NewInstance(env, mat);
+        }
+        return NewInstance(env, mat, owner_.Value());
+    }
+
+    Napi::Value MatWrap::GetData(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        { return ExportBuffer(info.Env(), mat_, GetOwner()); });
+    }
+
+    Napi::Value MatWrap::GetTypedData(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        { return ExportTypedArray(info.Env(), mat_, GetOwner()); });
+    }
+
+    Napi::Value MatWrap::Clone(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        { return NewInstance(info.Env(), CloneMat(mat_)); });
+    }
+
+    // 只有在调用方显式要求时才复制为连续内存，已经连续时直接共享
+    Napi::Value MatWrap::ToContinuous(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (mat_.isContinuous()) {
+                return WrapDerived(info.Env(), mat_);
+            }
+            return NewInstance(info.Env(), CloneMat(mat_)); });
+    }
+
+    // 子矩阵只创建新的 Mat 头，与原矩阵共享像素
+    Napi::Value MatWrap::Roi(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(info.Env(), "期望 Rect 对象参数");
+            }
+
+            cv::Rect rect = TypeConverter<cv::Rect>::FromNapi(info[0]);
+            return WrapDerived(info.Env(), mat_(rect)); });
+    }
+
+    // 在通道与维度之间重新解释形状，例如把 HxWx3 视为 3 平面，不复制像素
+    Napi::Value MatWrap::Reshape(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (info.Length() < 1 || !info[0].IsNumber()) {
+                throw Napi::TypeError::New(info.Env(), "期望 (cn[, sizes]) 参数");
+            }
+
+            int cn = info[0].As<Napi::Number>().Int32Value();
+            if (info.Length() > 1 && info[1].IsArray()) {
+                std::vector<int> sizes = ParseSizes(info[1]);
+                return WrapDerived(info.Env(), mat_.reshape(cn, static_cast<int>(sizes.size()), sizes.data()));
+            }
+            return WrapDerived(info.Env(), mat_.reshape(cn)); });
+    }
+
+    Napi::Value MatWrap::RowRange(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+                throw Napi::TypeError::New(info.Env(), "期望 (start, end) 数字参数");
+            }
+
+            int start = info[0].As<Napi::Number>().Int32Value();
+            int end = info[1].As<Napi::Number>().Int32Value();
+            return WrapDerived(info.Env(), mat_.rowRange(start, end)); });
+    }
+
+    Napi::Value MatWrap::ColRange(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+                throw Napi::TypeError::New(info.Env(), "期望 (start, end) 数字参数");
+            }
+
+            int start = info[0].As<Napi::Number>().Int32Value();
+            int end = info[1].As<Napi::Number>().Int32Value();
+            return WrapDerived(info.Env(), mat_.colRange(start, end)); });
+    }
+
+    // 返回子矩阵在父矩阵中的偏移与父矩阵尺寸
+    Napi::Value MatWrap::LocateROI(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            cv::Size wholeSize;
+            cv::Point ofs;
+            mat_.locateROI(wholeSize, ofs);
+
+            Napi::Object result = Napi::Object::New(info.Env());
+            result.Set("wholeSize", TypeConverter<cv::Size>::ToNapi(info.Env(), wholeSize));
+            Napi::Object ofsObj = Napi::Object::New(info.Env());
+            ofsObj.Set("x", Napi::Number::New(info.Env(), ofs.x));
+            ofsObj.Set("y", Napi::Number::New(info.Env(), ofs.y));
+            result.Set("ofs", ofsObj);
+            return result; });
+    }
+
+    Napi::Value MatWrap::ToObject(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        { return ToPlainObject(info.Env(), mat_, GetOwner()); });
+    }
+
+    Napi::Value MatWrap::FromObject(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(info.Env(), "期望 Mat 普通对象参数");
+            }
+
+            return NewInstance(info.Env(), FromPlainObject(info[0].As<Napi::Object>())); });
+    }
+
+    // Mat.fromBuffer(buffer, rows, cols, type[, step]) 或 Mat.fromBuffer(buffer, sizes, type[, steps])
+    // 把调用方内存直接包装为 Mat 头，不复制
+    Napi::Value MatWrap::FromBuffer(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            Napi::Env env = info.Env();
+
+            uint8_t *data = nullptr;
+            size_t length = 0;
+            if (info.Length() < 1 || !GetBytes(env, info[0], data, length)) {
+                throw Napi::TypeError::New(env, "期望 Buffer、TypedArray、DataView 或 ArrayBuffer");
+            }
+
+            std::vector<int> sizes;
+            std::vector<size_t> steps;
+            int type = 0;
+            if (info.Length() >= 3 && info[1].IsArray() && info[2].IsNumber()) {
+                sizes = ParseSizes(info[1]);
+                type = info[2].As<Napi::Number>().Int32Value();
+                if (info.Length() > 3 && info[3].IsArray()) {
+                    steps = ParseSteps(info[3]);
+                }
+            } else if (info.Length() >= 4 && info[1].IsNumber() && info[2].IsNumber() && info[3].IsNumber()) {
+                sizes = {info[1].As<Napi::Number>().Int32Value(), info[2].As<Napi::Number>().Int32Value()};
+                type = info[3].As<Napi::Number>().Int32Value();
+                if (info.Length() > 4 && info[4].IsNumber()) {
+                    steps = {static_cast<size_t>(info[4].As<Napi::Number>().Int64Value())};
+                }
+                if (sizes[0] <= 0 || sizes[1] <= 0) {
+                    throw Napi::RangeError::New(env, "rows 和 cols 必须为正数");
+                }
+            } else {
+                throw Napi::TypeError::New(env, "期望 (buffer, rows, cols, type[, step]) 或 (buffer, sizes, type[, steps]) 参数");
+            }
+
+            cv::Mat mat = MakeBorrowedHeader(data, length, sizes, type, steps);
+            return NewInstance(env, mat, info[0]); });
+    }
+
+    // ==================== 跨 worker 转移 ====================
+    // JS 的 transfer list 不接受原生对象，因此以令牌的形式转移：发送方 transfer() 后句柄被分离，
+    // 接收方用 Mat.adopt(token) 接管同一个 cv::Mat，像素不复制
+
+    Napi::Value MatWrap::Transfer(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            // 借用的 JS 内存属于发送方 isolate，转移前必须复制为原生内存
+            cv::Mat mat = owner_.IsEmpty() ? mat_ : CloneMat(mat_);
+
+            uint64_t token = nextTransferToken.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(transferMutex);
+                transferRegistry.emplace(token, PendingTransfer{mat, GetAddonData(info.Env())});
+            }
+
+            released_ = true;
+            mat_.release();
+            owner_.Reset();
+            return Napi::Number::New(info.Env(), static_cast<double>(token)); });
+    }
+
+    Napi::Value MatWrap::Adopt(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            if (info.Length() < 1 || !info[0].IsNumber()) {
+                throw Napi::TypeError::New(info.Env(), "期望 transfer() 返回的令牌");
+            }
+
+            uint64_t token = static_cast<uint64_t>(info[0].As<Napi::Number>().Int64Value());
+            cv::Mat mat;
+            {
+                std::lock_guard<std::mutex> lock(transferMutex);
+                auto it = transferRegistry.find(token);
+                if (it == transferRegistry.end()) {
+                    throw Napi::Error::New(info.Env(), "令牌无效或已被领取");
+                }
+                mat = it->second.mat;
+                transferRegistry.erase(it);
+            }
+            return NewInstance(info.Env(), mat); });
+    }
+
+    size_t MatWrap::DropPendingTransfers(const AddonData *issuer)
+    {
+        // 在锁外析构，像素内存的释放不阻塞其他 env 的 transfer/adopt
+        std::vector<cv::Mat> dropped;
+        {
+            std::lock_guard<std::mutex> lock(transferMutex);
+            for (auto it = transferRegistry.begin(); it != transferRegistry.end();)
+            {
+                if (it->second.issuer == issuer)
+                {
+                    dropped.push_back(std::move(it->second.mat));
+                    it = transferRegistry.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        return dropped.size();
+    }
+
+    // Mat.pendingTransfers()：进程内尚未被领取的令牌数
+    Napi::Value MatWrap::PendingTransfers(const Napi::CallbackInfo &info)
+    {
+        std::lock_guard<std::mutex> lock(transferMutex);
+        return Napi::Number::New(info.Env(), static_cast<double>(transferRegistry.size()));
+    }
+
+    // ==================== SharedArrayBuffer ====================
+    // 像素存放在 SharedArrayBuffer 中，postMessage 到其他 worker 时只共享不复制；
+    // 各 isolate 的 Mat 句柄固定各自的 SharedArrayBuffer 对象，底层内存由 V8 的共享 BackingStore 跨线程引用计数
+
+    // Mat.createShared(rows, cols, type) 或 Mat.createShared(sizes, type)
+    Napi::Value MatWrap::CreateShared(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            Napi::Env env = info.Env();
+
+            std::vector<int> sizes;
+            int type = 0;
+            if (info.Length() >= 2 && info[0].IsArray() && info[1].IsNumber()) {
+                sizes = ParseSizes(info[0]);
+                type = info[1].As<Napi::Number>().Int32Value();
+            } else if (info.Length() >= 3 && info[0].IsNumber() && info[1].IsNumber() && info[2].IsNumber()) {
+                sizes = {info[0].As<Napi::Number>().Int32Value(), info[1].As<Napi::Number>().Int32Value()};
+                type = info[2].As<Napi::Number>().Int32Value();
+                if (sizes[0] <= 0 || sizes[1] <= 0) {
+                    throw Napi::RangeError::New(env, "rows 和 cols 必须为正数");
+                }
+            } else {
+                throw Napi::TypeError::New(env, "期望 (rows, cols, type) 或 (sizes, type) 参数");
+            }
+
+            Napi::Value sabCtor = env.Global().Get("SharedArrayBuffer");
+            if (!sabCtor.IsFunction()) {
+                throw Napi::Error::New(env, "当前运行时不支持 SharedArrayBuffer");
+            }
+
+            size_t bytes = CV_ELEM_SIZE(type);
+            for (int size : sizes) {
+                bytes *= static_cast<size_t>(size);
+            }
+
+            Napi::Object sab = sabCtor.As<Napi::Function>().New({Napi::Number::New(env, static_cast<double>(bytes))});
+            uint8_t *data = nullptr;
+            size_t length = 0;
+            SharedBytes(env, sab, data, length);
+
+            return NewInstance(env, MakeBorrowedHeader(data, length, sizes, type, {}), sab); });
+    }
+
+    // Mat.fromShared({buffer, byteOffset, sizes, steps, type}) 在任意 worker 中包装同一块共享内存
+    Napi::Value MatWrap::FromShared(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            Napi::Env env = info.Env();
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(env, "期望共享 Mat 描述对象参数");
+            }
+
+            Napi::Object desc = info[0].As<Napi::Object>();
+            Napi::Value sab = SharedBufferOf(env, desc.Get("buffer"));
+            if (sab.IsEmpty() || !desc.Get("sizes").IsArray() || !desc.Get("type").IsNumber()) {
+                throw Napi::TypeError::New(env, "期望 {buffer: SharedArrayBuffer, sizes, type[, steps, byteOffset]}");
+            }
+
+            uint8_t *data = nullptr;
+            size_t length = 0;
+            SharedBytes(env, sab, data, length);
+
+            size_t byteOffset = 0;
+            if (desc.Get("byteOffset").IsNumber()) {
+                byteOffset = static_cast<size_t>(desc.Get("byteOffset").As<Napi::Number>().Int64Value());
+            }
+            if (byteOffset > length) {
+                throw Napi::RangeError::New(env, "byteOffset 超出 SharedArrayBuffer 范围");
+            }
+
+            std::vector<size_t> steps;
+            if (desc.Get("steps").IsArray()) {
+                steps = ParseSteps(desc.Get("steps"));
+            }
+
+            cv::Mat mat = MakeBorrowedHeader(data + byteOffset, length - byteOffset, ParseSizes(desc.Get("sizes")),
+                                             desc.Get("type").As<Napi::Number>().Int32Value(), steps);
+            return NewInstance(env, mat, sab); });
+    }
+
+    // 返回可通过 postMessage 发送的描述对象；已在共享内存中时不复制（ROI 同样适用），否则复制一次到新的 SharedArrayBuffer
+    Napi::Value MatWrap::ToShared(const Napi::CallbackInfo &info)
+    {
+        return SafeCall(info.Env(), [&]() -> Napi::Value
+                        {
+            Napi::Env env = info.Env();
+            if (mat_.empty()) {
+                throw Napi::Error::New(env, "空 Mat 无法共享");
+            }
+
+            cv::Mat shared = mat_;
+            Napi::Value sab = SharedBufferOf(env, GetOwner());
+            if (sab.IsEmpty()) {
+                Napi::Array sizes = ToNumberArray(env, mat_.size.p, mat_.dims);
+                Napi::Function create = GetAddonData(env)->matConstructor.Value().Get("createShared").As<Napi::Function>();
+                Napi::Object copy = create.Call({sizes, Napi::Number::New(env, mat_.type())}).As<Napi::Object>();
+
+                MatWrap *wrap = Unwrap(copy);
+                mat_.copyTo(wrap->mat_);
+                shared = wrap->mat_;
+                sab = wrap->GetOwner();
+            }
+
+            uint8_t *base = nullptr;
+            size_t length = 0;
+            SharedBytes(env, sab, base, length);
+
+            Napi::Object desc = Napi::Object::New(env);
+            desc.Set("buffer", sab);
+            desc.Set("byteOffset", Napi::Number::New(env, static_cast<double>(shared.data - base)));
+            desc.Set("sizes", ToNumberArray(env, shared.size.p, shared.dims));
+            desc.Set("steps", ToNumberArray(env, shared.step.p, shared.dims));
+            desc.Set("type", Napi::Number::New(env, shared.type()));
+            return desc; });
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
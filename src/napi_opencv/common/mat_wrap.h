@@ -0,0 +1,120 @@
+#ifndef NAPI_OPENCV_MAT_WRAP_H
+#define NAPI_OPENCV_MAT_WRAP_H
+
+#include <napi.h>
+#include <opencv2/core.hpp>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    struct AddonData;
+
+    // JS 侧的 Mat 句柄：持有引用计数的 cv::Mat，在各个调用之间传递时不复制像素
+    class MatWrap : public Napi::ObjectWrap<MatWrap>
+    {
+    public:
+        static void Init(Napi::Env env, Napi::Object exports);
+
+        // 以共享数据的方式包装 cv::Mat（只增加引用计数）
+        static Napi::Object NewInstance(Napi::Env env, const cv::Mat &mat);
+        // 包装借用外部内存的 Mat 头，owner 为内存所属的 JS 对象，句柄存活期间一直被固定
+        static Napi::Object NewInstance(Napi::Env env, const cv::Mat &mat, Napi::Value owner);
+        static bool IsInstance(Napi::Value value);
+        static MatWrap *FromValue(Napi::Value value);
+
+        // 普通对象形式 {rows, cols, type, data, ...}，仅供 toObject()/fromObject() 使用
+        // owner 为借用内存的所属对象，含义同 ExportBuffer
+        static Napi::Object ToPlainObject(Napi::Env env, const cv::Mat &mat, Napi::Value owner = Napi::Value());
+        static cv::Mat FromPlainObject(Napi::Object matObj);
+
+        // 从 mat.data 到最后一个元素末尾的字节数，按 step 计算，适用于 ROI 与带填充的行
+        static size_t SpanBytes(const cv::Mat &mat);
+
+        // 导出指向 mat.data 的外部 Buffer，由终结器持有 Mat 头以保持 UMatData 存活；
+        // mat 借用 JS 内存时必须传入 owner，终结器同时固定该对象，release() 或句柄被回收后 Buffer 仍然有效
+        static Napi::Buffer<uint8_t> ExportBuffer(Napi::Env env, const cv::Mat &mat, Napi::Value owner = Napi::Value());
+
+        // 按深度导出对应类型的视图（Float32Array、Uint16Array 等），与 ExportBuffer 共享同一块内存
+        static Napi::Value ExportTypedArray(Napi::Env env, const cv::Mat &mat, Napi::Value owner = Napi::Value());
+
+        // 丢弃 issuer 发出但尚未被领取的 transfer() 令牌并释放其像素，在发送方 env 的清理钩子中调用
+        static size_t DropPendingTransfers(const AddonData *issuer);
+
+        // 取得 Buffer / TypedArray / DataView / ArrayBuffer 的底层内存
+        static bool GetBytes(Napi::Env env, Napi::Value value, uint8_t *&data, size_t &length);
+
+        MatWrap(const Napi::CallbackInfo &info);
+        ~MatWrap();
+
+        const cv::Mat &GetMat() const { return mat_; }
+        bool IsReleased() const { return released_; }
+        // 借用内存的所属对象，自有内存的 Mat 返回空值；异步任务通过持有句柄本身来延续固定
+        Napi::Value GetOwner() const { return owner_.IsEmpty() ? Napi::Value() : owner_.Value(); }
+
+    private:
+        // ==================== 属性 ====================
+        Napi::Value GetRows(const Napi::CallbackInfo &info);
+        Napi::Value GetCols(const Napi::CallbackInfo &info);
+        Napi::Value GetChannels(const Napi::CallbackInfo &info);
+        Napi::Value GetType(const Napi::CallbackInfo &info);
+        Napi::Value GetDepth(const Napi::CallbackInfo &info);
+        Napi::Value GetDims(const Napi::CallbackInfo &info);
+        Napi::Value GetEmpty(const Napi::CallbackInfo &info);
+        Napi::Value GetElemSize(const Napi::CallbackInfo &info);
+        Napi::Value GetStep(const Napi::CallbackInfo &info);
+        Napi::Value GetSizes(const Napi::CallbackInfo &info);
+        Napi::Value GetSteps(const Napi::CallbackInfo &info);
+        Napi::Value GetTotal(const Napi::CallbackInfo &info);
+        Napi::Value GetIsReleased(const Napi::CallbackInfo &info);
+        Napi::Value GetIsShared(const Napi::CallbackInfo &info);
+        Napi::Value GetIsContinuous(const Napi::CallbackInfo &info);
+        Napi::Value GetIsSubmatrix(const Napi::CallbackInfo &info);
+
+        // ==================== 方法 ====================
+        Napi::Value GetTypedData(const Napi::CallbackInfo &info);
+        Napi::Value GetData(const Napi::CallbackInfo &info);
+        Napi::Value Clone(const Napi::CallbackInfo &info);
+        Napi::Value ToContinuous(const Napi::CallbackInfo &info);
+        Napi::Value Roi(const Napi::CallbackInfo &info);
+        Napi::Value Reshape(const Napi::CallbackInfo &info);
+        Napi::Value RowRange(const Napi::CallbackInfo &info);
+        Napi::Value ColRange(const Napi::CallbackInfo &info);
+        Napi::Value LocateROI(const Napi::CallbackInfo &info);
+        Napi::Value ToObject(const Napi::CallbackInfo &info);
+        Napi::Value Release(const Napi::CallbackInfo &info);
+        static Napi::Value FromObject(const Napi::CallbackInfo &info);
+        static Napi::Value FromBuffer(const Napi::CallbackInfo &info);
+
+        // ==================== 跨 worker 转移 ====================
+        Napi::Value Transfer(const Napi::CallbackInfo &info);
+        static Napi::Value Adopt(const Napi::CallbackInfo &info);
+        static Napi::Value PendingTransfers(const Napi::CallbackInfo &info);
+
+        // ==================== 共享内存 ====================
+        Napi::Value ToShared(const Napi::CallbackInfo &info);
+        static Napi::Value CreateShared(const Napi::CallbackInfo &info);
+        static Napi::Value FromShared(const Napi::CallbackInfo &info);
+
+        // 在 Init 中包装除 isReleased / release 之外的实例属性与方法：release() 之后访问时抛出 "Mat 已释放"
+        template <Napi::Value (MatWrap::*Method)(const Napi::CallbackInfo &)>
+        Napi::Value Checked(const Napi::CallbackInfo &info);
+
+        // 包装与本 Mat 共享内存的子矩阵头，借用内存时沿用同一个所属对象
+        Napi::Object WrapDerived(Napi::Env env, const cv::Mat &mat);
+
+        // ExportBuffer 的终结器参数
+        struct ExportHold
+        {
+            cv::Mat mat;
+            Napi::ObjectReference owner;
+        };
+
+        cv::Mat mat_;
+        Napi::ObjectReference owner_;
+        bool released_ = false;
+    };
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_MAT_WRAP_H
@@ -0,0 +1,235 @@
+#include "parallel_backend.h"
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    namespace
+    {
+        // 0 表示当前线程没有设置预算
+        thread_local int threadBudget = 0;
+        // 并行区域内的线程序号，调用线程为 0
+        thread_local int threadNum = 0;
+    } // namespace
+
+    BudgetParallelBackend::BudgetParallelBackend()
+    {
+        maxThreads_ = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        defaultThreads_ = maxThreads_;
+    }
+
+    std::shared_ptr<BudgetParallelBackend> BudgetParallelBackend::Instance()
+    {
+        // 故意不析构：辅助线程在进程退出前一直引用后端
+        static std::shared_ptr<BudgetParallelBackend> *instance =
+            new std::shared_ptr<BudgetParallelBackend>(new BudgetParallelBackend());
+        return *instance;
+    }
+
+    void BudgetParallelBackend::Install()
+    {
+        static std::once_flag installed;
+        std::call_once(installed, []()
+                       { cv::parallel::setParallelForBackend(Instance(), false); });
+    }
+
+    BudgetParallelBackend::BudgetScope::BudgetScope(int threads) : previous_(threadBudget)
+    {
+        threadBudget = threads;
+    }
+
+    BudgetParallelBackend::BudgetScope::~BudgetScope()
+    {
+        threadBudget = previous_;
+    }
+
+    // OpenCV 在进程内同一时刻只并行一个顶层 parallel_for_，其余调用在各自线程中串行执行；
+    // 这里再按调用线程的预算限制该区域可使用的线程数
+    void BudgetParallelBackend::parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void *callback_data)
+    {
+        Region region;
+        region.callback = body_callback;
+        region.data = callback_data;
+        region.tasks = tasks;
+
+        int threads = std::min(getNumThreads(), tasks);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (threads <= 1 || region_ != nullptr)
+            {
+                threads = 1;
+            }
+            else
+            {
+                EnsureHelpersLocked(threads - 1);
+                region_ = &region;
+                tickets_ = threads - 1;
+                wake_.notify_all();
+            }
+        }
+
+        if (threads <= 1)
+        {
+            body_callback(0, tasks, callback_data);
+            return;
+        }
+
+        RunStripes(region);
+
+        // 收回未被领取的名额，等待已经加入的辅助线程做完
+        std::unique_lock<std::mutex> lock(mutex_);
+        tickets_ = 0;
+        finished_.wait(lock, [this]()
+                       { return activeHelpers_ == 0; });
+        region_ = nullptr;
+    }
+
+    void BudgetParallelBackend::RunStripes(Region &region)
+    {
+        for (;;)
+        {
+            int stripe = region.next.fetch_add(1, std::memory_order_relaxed);
+            if (stripe >= region.tasks)
+            {
+                return;
+            }
+            region.callback(stripe, stripe + 1, region.data);
+        }
+    }
+
+    int BudgetParallelBackend::getThreadNum() const
+    {
+        return threadNum;
+    }
+
+    int BudgetParallelBackend::getNumThreads() const
+    {
+        int budget = threadBudget > 0 ? threadBudget : defaultThreads_.load(std::memory_order_relaxed);
+        return std::max(1, std::min(budget, maxThreads_));
+    }
+
+    // 没有预算的线程（如同步调用所在的 JS 线程）使用的默认值；与 OpenCV 一致，0 为串行，负数为 CPU 核数
+    int BudgetParallelBackend::setNumThreads(int nThreads)
+    {
+        defaultThreads_ = nThreads < 0 ? maxThreads_ : std::max(1, std::min(nThreads, maxThreads_));
+        return defaultThreads_;
+    }
+
+    void BudgetParallelBackend::EnsureHelpersLocked(int count)
+    {
+        while (helpers_ < count)
+        {
+            helpers_++;
+            std::thread(&BudgetParallelBackend::HelperLoop, this, helpers_).detach();
+        }
+    }
+
+    void BudgetParallelBackend::HelperLoop(int index)
+    {
+        threadNum = index;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            wake_.wait(lock, [this]()
+                       { return tickets_ > 0; });
+
+            tickets_--;
+            activeHelpers_++;
+            Region *region = region_;
+            lock.unlock();
+
+            RunStripes(*region);
+
+            lock.lock();
+            if (--activeHelpers_ == 0)
+            {
+                finished_.notify_all();
+            }
+        }
+    }
+
+    namespace
+    {
+        // OpenCV 的 currentParallelFramework() 不在公开头文件中，由这里记录切换结果
+        std::mutex backendMutex;
+        std::string activeBackend = "opencv-napi";
+
+        void ActivateBackendLocked(const std::string &name)
+        {
+            if (name == "opencv-napi")
+            {
+                // 其他后端下 SetSyncThreads 写入的是 OpenCV 的全局线程数，为 0 或 1 时 parallel_for_ 不调用任何后端，
+                // 先在原后端上恢复默认值；同步调用的线程数由本后端自己保存
+                if (activeBackend != "opencv-napi")
+                {
+                    cv::setNumThreads(-1);
+                }
+                cv::parallel::setParallelForBackend(BudgetParallelBackend::Instance(), false);
+            }
+            else if (name == "builtin")
+            {
+                cv::parallel::setParallelForBackend(std::shared_ptr<cv::parallel::ParallelForAPI>(), true);
+            }
+            else
+            {
+                cv::parallel::setParallelForBackend(name, true);
+            }
+        }
+    } // namespace
+
+    bool SelectParallelBackend(const std::string &name)
+    {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+
+        std::lock_guard<std::mutex> lock(backendMutex);
+        if (lower == "opencv-napi" || lower == "builtin")
+        {
+            ActivateBackendLocked(lower);
+            activeBackend = lower;
+            return true;
+        }
+
+        // 当前后端不是由注册表创建时，注册表记录的仍是它最近一次选中的名称；若正是所请求的后端，
+        // 按名称切换会被当作空操作而保留当前后端，因此先按空名称让注册表重新选择一次
+        if (activeBackend == "opencv-napi" || activeBackend == "builtin")
+        {
+            cv::parallel::setParallelForBackend(std::string(), false);
+        }
+
+        if (cv::parallel::setParallelForBackend(lower, true))
+        {
+            activeBackend = lower;
+            return true;
+        }
+
+        // 失败时 OpenCV 已退回内置实现，恢复到切换之前的后端
+        ActivateBackendLocked(activeBackend);
+        return false;
+    }
+
+    void SetSyncThreads(int threads)
+    {
+        std::lock_guard<std::mutex> lock(backendMutex);
+        if (activeBackend == "opencv-napi")
+        {
+            BudgetParallelBackend::Instance()->setNumThreads(threads);
+        }
+        else
+        {
+            cv::setNumThreads(threads);
+        }
+    }
+
+    std::string CurrentParallelBackend()
+    {
+        std::lock_guard<std::mutex> lock(backendMutex);
+        return activeBackend;
+    }
+
+} // namespace Common
+} // namespace NapiOpenCV
@@ -0,0 +1,85 @@
+#ifndef NAPI_OPENCV_PARALLEL_BACKEND_H
+#define NAPI_OPENCV_PARALLEL_BACKEND_H
+
+#include <opencv2/core.hpp>
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace NapiOpenCV {
+namespace Common {
+
+    // 替换 OpenCV 的 parallel_for_ 后端：每个线程按自己的线程预算执行并行区域，
+    // 使并发的后台任务不会各自占满所有核心
+    class BudgetParallelBackend : public cv::parallel::ParallelForAPI
+    {
+    public:
+        static std::shared_ptr<BudgetParallelBackend> Instance();
+
+        // 安装为 OpenCV 的并行后端，进程内只执行一次
+        static void Install();
+
+        void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void *callback_data) override;
+        int getThreadNum() const override;
+        int getNumThreads() const override;
+        int setNumThreads(int nThreads) override;
+        const char *getName() const override { return "opencv-napi"; }
+
+        // 在作用域内设置当前线程的线程预算，threads <= 0 时使用默认值
+        class BudgetScope
+        {
+        public:
+            explicit BudgetScope(int threads);
+            ~BudgetScope();
+
+        private:
+            int previous_;
+        };
+
+    private:
+        struct Region
+        {
+            FN_parallel_for_body_cb_t callback = nullptr;
+            void *data = nullptr;
+            int tasks = 0;
+            std::atomic<int> next{0};
+        };
+
+        BudgetParallelBackend();
+
+        void RunStripes(Region &region);
+        void EnsureHelpersLocked(int count);
+        void HelperLoop(int threadNum);
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable finished_;
+        Region *region_ = nullptr;
+        int tickets_ = 0;
+        int activeHelpers_ = 0;
+        int helpers_ = 0;
+        int maxThreads_ = 1;
+        std::atomic<int> defaultThreads_{1};
+    };
+
+    // 切换 OpenCV 的 parallel_for_ 后端：
+    // "opencv-napi" 为按任务预算执行的默认后端，"builtin" 为 OpenCV 编译时内置的实现（如 pthreads），
+    // 其他名称（"tbb"、"onetbb"、"openmp"）交给 OpenCV 的后端注册表，从插件加载；不可用时返回 false 并保持原后端
+    // OpenCV 不保证切换的线程安全，调用方需确保没有正在执行的并行区域
+    bool SelectParallelBackend(const std::string &name);
+
+    // 同步调用使用的线程数，0 为串行，负数恢复为 CPU 核数。默认后端下只修改本后端保存的默认值，
+    // 不写入 OpenCV 的全局线程数：后者为 0 或 1 时 parallel_for_ 跳过所有后端，异步任务的线程预算也会随之失效；
+    // 其他后端没有按线程的预算，交给 cv::setNumThreads
+    void SetSyncThreads(int threads);
+
+    // 当前生效的后端名称，即最近一次成功切换时使用的名称（小写）
+    std::string CurrentParallelBackend();
+
+} // namespace Common
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_PARALLEL_BACKEND_H
@@ -1,5 +1,8 @@
 #include "type_converters.h"
+#include "mat_wrap.h"
+#include "allocator.h"
 #include <opencv2/core.hpp>
+#include <cstring>
 
 namespace NapiOpenCV {
 namespace Common {
@@ -41,56 +44,32 @@ namespace Common {
         return value.As<Napi::String>().Utf8Value();
     }
 
-    // Mat 类型转换器实现
+    // Mat 类型转换器实现：返回共享数据的 Mat 句柄，不复制像素
     template <>
     Napi::Value TypeConverter<cv::Mat>::ToNapi(Napi::Env env, const cv::Mat &mat)
     {
-        Napi::Object matObj = Napi::Object::New(env);
-
-        matObj.Set("rows", Napi::Number::New(env, mat.rows));
-        matObj.Set("cols", Napi::Number::New(env, mat.cols));
-        matObj.Set("channels", Napi::Number::New(env, mat.channels()));
-        matObj.Set("type", Napi::Number::New(env, mat.type()));
-        matObj.Set("depth", Napi::Number::New(env, mat.depth()));
-        matObj.Set("dims", Napi::Number::New(env, mat.dims));
-        matObj.Set("empty", Napi::Boolean::New(env, mat.empty()));
-        matObj.Set("elemSize", Napi::Number::New(env, mat.elemSize()));
-        matObj.Set("step", Napi::Number::New(env, mat.step[0]));
-
-        if (!mat.empty())
+        // 借用外部内存的 Mat 头无法在此处确定所属对象，需要复制为自有内存后再返回
+        if (!mat.empty() && mat.u == nullptr)
         {
-            size_t dataSize = mat.total() * mat.elemSize();
-            Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, dataSize);
-            memcpy(buffer.Data(), mat.data, dataSize);
-            matObj.Set("data", buffer);
+            return MatWrap::NewInstance(env, CloneMat(mat));
         }
-
-        return matObj;
+        return MatWrap::NewInstance(env, mat);
     }
 
     template <>
     cv::Mat TypeConverter<cv::Mat>::FromNapi(Napi::Value value)
     {
-        if (!value.IsObject())
+        MatWrap *wrap = MatWrap::FromValue(value);
+        if (wrap == nullptr)
         {
-            throw std::invalid_argument("期望 Mat 对象");
+            throw std::invalid_argument("期望 Mat 对象（普通对象请先使用 Mat.fromObject() 转换）");
         }
-
-        Napi::Object matObj = value.As<Napi::Object>();
-
-        int rows = matObj.Get("rows").As<Napi::Number>().Int32Value();
-        int cols = matObj.Get("cols").As<Napi::Number>().Int32Value();
-        int type = matObj.Get("type").As<Napi::Number>().Int32Value();
-
-        cv::Mat mat(rows, cols, type);
-
-        if (matObj.Has("data"))
+        if (wrap->IsReleased())
         {
-            Napi::Buffer<uint8_t> buffer = matObj.Get("data").As<Napi::Buffer<uint8_t>>();
-            memcpy(mat.data, buffer.Data(), buffer.Length());
+            throw std::invalid_argument("Mat 已释放");
         }
 
-        return mat;
+        return wrap->GetMat();
     }
 
     // Point2f 类型转换器实现
@@ -209,23 +188,44 @@ namespace Common {
     }
 
     // vector<Point2f> 类型转换器实现
+    // 输出为交错的 Float32Array [x0, y0, x1, y1, ...]，大量关键点/轮廓点时避免逐个创建对象
+    static_assert(sizeof(cv::Point2f) == 2 * sizeof(float), "Point2f 必须紧密排列");
+    static_assert(sizeof(cv::Rect) == 4 * sizeof(int32_t), "Rect 必须紧密排列");
+
     template <>
     Napi::Value TypeConverter<std::vector<cv::Point2f>>::ToNapi(Napi::Env env, const std::vector<cv::Point2f> &points)
     {
-        Napi::Array pointsArray = Napi::Array::New(env, points.size());
-        for (size_t i = 0; i < points.size(); i++)
+        Napi::Float32Array packed = Napi::Float32Array::New(env, points.size() * 2);
+        if (!points.empty())
         {
-            pointsArray.Set(i, TypeConverter<cv::Point2f>::ToNapi(env, points[i]));
+            std::memcpy(packed.Data(), points.data(), points.size() * sizeof(cv::Point2f));
         }
-        return pointsArray;
+        return packed;
     }
 
+    // 接受打包的 Float32Array 或 {x, y} 对象数组
     template <>
     std::vector<cv::Point2f> TypeConverter<std::vector<cv::Point2f>>::FromNapi(Napi::Value value)
     {
+        if (value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_float32_array)
+        {
+            Napi::Float32Array packed = value.As<Napi::Float32Array>();
+            if (packed.ElementLength() % 2 != 0)
+            {
+                throw std::invalid_argument("打包的 Point2f 数组长度必须为 2 的倍数");
+            }
+
+            std::vector<cv::Point2f> points(packed.ElementLength() / 2);
+            if (!points.empty())
+            {
+                std::memcpy(points.data(), packed.Data(), points.size() * sizeof(cv::Point2f));
+            }
+            return points;
+        }
+
         if (!value.IsArray())
         {
-            throw std::invalid_argument("期望 Point2f 数组");
+            throw std::invalid_argument("期望 Float32Array 或 Point2f 数组");
         }
 
         Napi::Array array = value.As<Napi::Array>();
@@ -241,23 +241,41 @@ namespace Common {
     }
 
     // vector<Rect> 类型转换器实现
+    // 输出为 Int32Array [x0, y0, w0, h0, x1, ...]
     template <>
     Napi::Value TypeConverter<std::vector<cv::Rect>>::ToNapi(Napi::Env env, const std::vector<cv::Rect> &rects)
     {
-        Napi::Array rectsArray = Napi::Array::New(env, rects.size());
-        for (size_t i = 0; i < rects.size(); i++)
+        Napi::Int32Array packed = Napi::Int32Array::New(env, rects.size() * 4);
+        if (!rects.empty())
         {
-            rectsArray.Set(i, TypeConverter<cv::Rect>::ToNapi(env, rects[i]));
+            std::memcpy(packed.Data(), rects.data(), rects.size() * sizeof(cv::Rect));
         }
-        return rectsArray;
+        return packed;
     }
 
+    // 接受打包的 Int32Array 或 {x, y, width, height} 对象数组
     template <>
     std::vector<cv::Rect> TypeConverter<std::vector<cv::Rect>>::FromNapi(Napi::Value value)
     {
+        if (value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_int32_array)
+        {
+            Napi::Int32Array packed = value.As<Napi::Int32Array>();
+            if (packed.ElementLength() % 4 != 0)
+            {
+                throw std::invalid_argument("打包的 Rect 数组长度必须为 4 的倍数");
+            }
+
+            std::vector<cv::Rect> rects(packed.ElementLength() / 4);
+            if (!rects.empty())
+            {
+                std::memcpy(rects.data(), packed.Data(), rects.size() * sizeof(cv::Rect));
+            }
+            return rects;
+        }
+
         if (!value.IsArray())
         {
-            throw std::invalid_argument("期望 Rect 数组");
+            throw std::invalid_argument("期望 Int32Array 或 Rect 数组");
         }
 
         Napi::Array array = value.As<Napi::Array>();
@@ -272,6 +290,38 @@ namespace Common {
         return rects;
     }
 
+    // Mat 数组类型转换器实现
+    template <>
+    Napi::Value TypeConverter<std::vector<cv::Mat>>::ToNapi(Napi::Env env, const std::vector<cv::Mat> &mats)
+    {
+        Napi::Array array = Napi::Array::New(env, mats.size());
+        for (size_t i = 0; i < mats.size(); i++)
+        {
+            array.Set(static_cast<uint32_t>(i), TypeConverter<cv::Mat>::ToNapi(env, mats[i]));
+        }
+        return array;
+    }
+
+    template <>
+    std::vector<cv::Mat> TypeConverter<std::vector<cv::Mat>>::FromNapi(Napi::Value value)
+    {
+        if (!value.IsArray())
+        {
+            throw std::invalid_argument("期望 Mat 数组");
+        }
+
+        Napi::Array array = value.As<Napi::Array>();
+        std::vector<cv::Mat> mats;
+        mats.reserve(array.Length());
+
+        for (uint32_t i = 0; i < array.Length(); i++)
+        {
+            mats.push_back(TypeConverter<cv::Mat>::FromNapi(array.Get(i)));
+        }
+
+        return mats;
+    }
+
     // int64_t 类型转换器实现
     template <>
     Napi::Value TypeConverter<int64_t>::ToNapi(Napi::Env env, const int64_t &value)
@@ -82,6 +82,12 @@ namespace Common {
     template <>
     std::vector<cv::Rect> TypeConverter<std::vector<cv::Rect>>::FromNapi(Napi::Value value);
 
+    template <>
+    Napi::Value TypeConverter<std::vector<cv::Mat>>::ToNapi(Napi::Env env, const std::vector<cv::Mat> &mats);
+
+    template <>
+    std::vector<cv::Mat> TypeConverter<std::vector<cv::Mat>>::FromNapi(Napi::Value value);
+
     template <>
     Napi::Value TypeConverter<int64_t>::ToNapi(Napi::Env env, const int64_t &value);
 
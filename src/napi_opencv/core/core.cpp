@@ -1,7 +1,13 @@
 #include "core.h"
+#include "../common/addon_data.h"
+#include "../common/buffer_pool.h"
+#include "../common/cpu_topology.h"
+#include "../common/job_scheduler.h"
+#include "../common/parallel_backend.h"
 #include "../common/safe_call.h"
 #include "../common/type_converters.h"
 #include <opencv2/core.hpp>
+#include <algorithm>
 
 using namespace NapiOpenCV::Common;
 
@@ -22,6 +28,24 @@ namespace NapiOpenCV
             exports.Set("getVersionMinor", Napi::Function::New(env, GetVersionMinor));
             exports.Set("getVersionRevision", Napi::Function::New(env, GetVersionRevision));
 
+            // 点与矩形数组在打包形式与对象形式之间转换
+            exports.Set("packPoints", Napi::Function::New(env, PackPoints));
+            exports.Set("unpackPoints", Napi::Function::New(env, UnpackPoints));
+            exports.Set("packRects", Napi::Function::New(env, PackRects));
+            exports.Set("unpackRects", Napi::Function::New(env, UnpackRects));
+
+            // 后台任务调度器
+            exports.Set("schedulerConfigure", Napi::Function::New(env, SchedulerConfigure));
+            exports.Set("schedulerStats", Napi::Function::New(env, SchedulerStats));
+            exports.Set("setParallelBackend", Napi::Function::New(env, SetParallelBackend));
+            exports.Set("getParallelBackend", Napi::Function::New(env, GetParallelBackend));
+            exports.Set("cpuTopology", Napi::Function::New(env, GetCpuTopology));
+
+            // 缓冲池
+            exports.Set("bufferPoolStats", Napi::Function::New(env, BufferPoolStats));
+            exports.Set("bufferPoolConfigure", Napi::Function::New(env, BufferPoolConfigure));
+            exports.Set("bufferPoolTrim", Napi::Function::New(env, BufferPoolTrim));
+
             // 基础数学运算函数
             exports.Set("add", Napi::Function::New(env, Add));
             exports.Set("subtract", Napi::Function::New(env, Subtract));
@@ -149,7 +173,7 @@ namespace NapiOpenCV
             }
             
             int nthreads = info[0].As<Napi::Number>().Int32Value();
-            cv::setNumThreads(nthreads);
+            SetSyncThreads(nthreads);
             return info.Env().Undefined(); });
         }
 
@@ -183,6 +207,301 @@ namespace NapiOpenCV
                             { return TypeConverter<int>::ToNapi(info.Env(), CV_VERSION_REVISION); });
         }
 
+        // ==================== 点与矩形数组打包实现 ====================
+        // 绑定函数默认输出打包形式，需要对象形式时再用 unpack* 展开
+
+        Napi::Value PackPoints(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1) {
+                throw Napi::TypeError::New(info.Env(), "期望 Point2f 数组参数");
+            }
+            return TypeConverter<std::vector<cv::Point2f>>::ToNapi(
+                info.Env(), TypeConverter<std::vector<cv::Point2f>>::FromNapi(info[0])); });
+        }
+
+        Napi::Value UnpackPoints(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1) {
+                throw Napi::TypeError::New(info.Env(), "期望 Float32Array 参数");
+            }
+
+            std::vector<cv::Point2f> points = TypeConverter<std::vector<cv::Point2f>>::FromNapi(info[0]);
+            Napi::Array result = Napi::Array::New(info.Env(), points.size());
+            for (size_t i = 0; i < points.size(); i++) {
+                result.Set(static_cast<uint32_t>(i), TypeConverter<cv::Point2f>::ToNapi(info.Env(), points[i]));
+            }
+            return result; });
+        }
+
+        Napi::Value PackRects(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1) {
+                throw Napi::TypeError::New(info.Env(), "期望 Rect 数组参数");
+            }
+            return TypeConverter<std::vector<cv::Rect>>::ToNapi(
+                info.Env(), TypeConverter<std::vector<cv::Rect>>::FromNapi(info[0])); });
+        }
+
+        Napi::Value UnpackRects(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1) {
+                throw Napi::TypeError::New(info.Env(), "期望 Int32Array 参数");
+            }
+
+            std::vector<cv::Rect> rects = TypeConverter<std::vector<cv::Rect>>::FromNapi(info[0]);
+            Napi::Array result = Napi::Array::New(info.Env(), rects.size());
+            for (size_t i = 0; i < rects.size(); i++) {
+                result.Set(static_cast<uint32_t>(i), TypeConverter<cv::Rect>::ToNapi(info.Env(), rects[i]));
+            }
+            return result; });
+        }
+
+        // ==================== 缓冲池函数实现 ====================
+
+        Napi::Value BufferPoolStats(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            BufferPool::Stats stats = BufferPool::Instance().GetStats();
+
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+            result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+            result.Set("evictions", Napi::Number::New(env, static_cast<double>(stats.evictions)));
+            result.Set("trims", Napi::Number::New(env, static_cast<double>(stats.trims)));
+            result.Set("cachedBytes", Napi::Number::New(env, static_cast<double>(stats.cachedBytes)));
+            result.Set("cachedBuffers", Napi::Number::New(env, static_cast<double>(stats.cachedBuffers)));
+            result.Set("maxBytes", Napi::Number::New(env, static_cast<double>(stats.maxBytes)));
+            result.Set("idleMs", Napi::Number::New(env, static_cast<double>(stats.idleMs)));
+            result.Set("enabled", Napi::Boolean::New(env, stats.enabled));
+            return result; });
+        }
+
+        // bufferPoolConfigure({maxBytes, idleMs, enabled})，未给出的字段保持原值
+        Napi::Value BufferPoolConfigure(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(info.Env(), "期望配置对象参数");
+            }
+
+            Napi::Object options = info[0].As<Napi::Object>();
+            BufferPool::Stats current = BufferPool::Instance().GetStats();
+
+            size_t maxBytes = current.maxBytes;
+            int64_t idleMs = current.idleMs;
+            bool enabled = current.enabled;
+            if (options.Has("maxBytes") && options.Get("maxBytes").IsNumber()) {
+                double value = options.Get("maxBytes").As<Napi::Number>().DoubleValue();
+                if (value < 0) {
+                    throw Napi::RangeError::New(info.Env(), "maxBytes 不能为负数");
+                }
+                maxBytes = static_cast<size_t>(value);
+            }
+            if (options.Has("idleMs") && options.Get("idleMs").IsNumber()) {
+                idleMs = options.Get("idleMs").As<Napi::Number>().Int64Value();
+            }
+            if (options.Has("enabled") && options.Get("enabled").IsBoolean()) {
+                enabled = options.Get("enabled").As<Napi::Boolean>().Value();
+            }
+
+            BufferPool::Instance().Configure(maxBytes, idleMs, enabled);
+            return info.Env().Undefined(); });
+        }
+
+        // 立即把缓存降到 targetBytes（默认 0）以下
+        Napi::Value BufferPoolTrim(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            size_t targetBytes = 0;
+            if (info.Length() > 0 && info[0].IsNumber()) {
+                targetBytes = static_cast<size_t>(std::max(0.0, info[0].As<Napi::Number>().DoubleValue()));
+            }
+
+            BufferPool::Instance().Trim(targetBytes);
+            return info.Env().Undefined(); });
+        }
+
+        // ==================== 任务调度器函数实现 ====================
+
+        // schedulerConfigure({workers, maxQueue, policy: 'reject' | 'wait', waitTimeoutMs, threadsPerJob, reservedWorkers, interactiveWeight, affinity: 'none' | 'core' | 'node'})，未给出的字段保持原值
+        Napi::Value SchedulerConfigure(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(info.Env(), "期望配置对象参数");
+            }
+
+            Napi::Object options = info[0].As<Napi::Object>();
+            JobScheduler::Config config = JobScheduler::Instance().GetConfig();
+
+            if (options.Has("workers") && options.Get("workers").IsNumber()) {
+                config.workers = options.Get("workers").As<Napi::Number>().Int32Value();
+            }
+            if (options.Has("maxQueue") && options.Get("maxQueue").IsNumber()) {
+                int64_t maxQueue = options.Get("maxQueue").As<Napi::Number>().Int64Value();
+                if (maxQueue < 1) {
+                    throw Napi::RangeError::New(info.Env(), "maxQueue 必须为正数");
+                }
+                config.maxQueue = static_cast<size_t>(maxQueue);
+            }
+            if (options.Has("policy") && options.Get("policy").IsString()) {
+                std::string policy = options.Get("policy").As<Napi::String>().Utf8Value();
+                if (policy == "reject") {
+                    config.policy = JobScheduler::FullPolicy::Reject;
+                } else if (policy == "wait") {
+                    config.policy = JobScheduler::FullPolicy::Wait;
+                } else {
+                    throw Napi::RangeError::New(info.Env(), "policy 只能为 'reject' 或 'wait'");
+                }
+            }
+            if (options.Has("waitTimeoutMs") && options.Get("waitTimeoutMs").IsNumber()) {
+                config.waitTimeoutMs = std::max<int64_t>(0, options.Get("waitTimeoutMs").As<Napi::Number>().Int64Value());
+            }
+            if (options.Has("threadsPerJob") && options.Get("threadsPerJob").IsNumber()) {
+                config.threadsPerJob = std::max(1, options.Get("threadsPerJob").As<Napi::Number>().Int32Value());
+            }
+            if (options.Has("reservedWorkers") && options.Get("reservedWorkers").IsNumber()) {
+                config.reservedWorkers = options.Get("reservedWorkers").As<Napi::Number>().Int32Value();
+            }
+            if (options.Has("interactiveWeight") && options.Get("interactiveWeight").IsNumber()) {
+                config.interactiveWeight = options.Get("interactiveWeight").As<Napi::Number>().Int32Value();
+            }
+            if (options.Has("affinity") && options.Get("affinity").IsString()) {
+                std::string affinity = options.Get("affinity").As<Napi::String>().Utf8Value();
+                if (affinity == "none") {
+                    config.affinity = JobScheduler::Affinity::None;
+                } else if (affinity == "core") {
+                    config.affinity = JobScheduler::Affinity::Core;
+                } else if (affinity == "node") {
+                    config.affinity = JobScheduler::Affinity::Node;
+                } else {
+                    throw Napi::RangeError::New(info.Env(), "affinity 只能为 'none'、'core' 或 'node'");
+                }
+            }
+
+            JobScheduler::Instance().Configure(config);
+            return info.Env().Undefined(); });
+        }
+
+        Napi::Value SchedulerStats(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            JobScheduler::Config config = JobScheduler::Instance().GetConfig();
+            JobScheduler::Stats stats = JobScheduler::Instance().GetStats();
+            double finished = stats.completed > 0 ? static_cast<double>(stats.completed) : 1.0;
+
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("workers", Napi::Number::New(env, stats.workers));
+            result.Set("envs", Napi::Number::New(env, LiveEnvCount()));
+            result.Set("maxQueue", Napi::Number::New(env, static_cast<double>(config.maxQueue)));
+            result.Set("threadsPerJob", Napi::Number::New(env, config.threadsPerJob));
+            result.Set("policy", Napi::String::New(env, config.policy == JobScheduler::FullPolicy::Wait ? "wait" : "reject"));
+            result.Set("queueDepth", Napi::Number::New(env, static_cast<double>(stats.queueDepth)));
+            result.Set("waiting", Napi::Number::New(env, static_cast<double>(stats.waiting)));
+            result.Set("running", Napi::Number::New(env, static_cast<double>(stats.running)));
+            result.Set("submitted", Napi::Number::New(env, static_cast<double>(stats.submitted)));
+            result.Set("completed", Napi::Number::New(env, static_cast<double>(stats.completed)));
+            result.Set("rejected", Napi::Number::New(env, static_cast<double>(stats.rejected)));
+            result.Set("cancelled", Napi::Number::New(env, static_cast<double>(stats.cancelled)));
+            result.Set("avgWaitMs", Napi::Number::New(env, stats.totalWaitMs / finished));
+            result.Set("maxWaitMs", Napi::Number::New(env, stats.maxWaitMs));
+            result.Set("avgRunMs", Napi::Number::New(env, stats.totalRunMs / finished));
+            result.Set("maxRunMs", Napi::Number::New(env, stats.maxRunMs));
+            result.Set("reservedWorkers", Napi::Number::New(env, config.reservedWorkers));
+            result.Set("interactiveWeight", Napi::Number::New(env, config.interactiveWeight));
+            const char *affinityNames[] = {"none", "core", "node"};
+            result.Set("affinity", Napi::String::New(env, affinityNames[static_cast<int>(config.affinity)]));
+
+            const char *laneNames[] = {"interactive", "bulk"};
+            Napi::Object lanes = Napi::Object::New(env);
+            for (int i = 0; i < 2; i++) {
+                const JobScheduler::LaneStats &lane = stats.lanes[i];
+                double laneFinished = lane.completed > 0 ? static_cast<double>(lane.completed) : 1.0;
+                Napi::Object laneObj = Napi::Object::New(env);
+                laneObj.Set("queueDepth", Napi::Number::New(env, static_cast<double>(lane.queueDepth)));
+                laneObj.Set("waiting", Napi::Number::New(env, static_cast<double>(lane.waiting)));
+                laneObj.Set("running", Napi::Number::New(env, static_cast<double>(lane.running)));
+                laneObj.Set("submitted", Napi::Number::New(env, static_cast<double>(lane.submitted)));
+                laneObj.Set("completed", Napi::Number::New(env, static_cast<double>(lane.completed)));
+                laneObj.Set("avgWaitMs", Napi::Number::New(env, lane.totalWaitMs / laneFinished));
+                laneObj.Set("maxWaitMs", Napi::Number::New(env, lane.maxWaitMs));
+                lanes.Set(laneNames[i], laneObj);
+            }
+            result.Set("lanes", lanes);
+            return result; });
+        }
+
+        // setParallelBackend('opencv-napi' | 'builtin' | 'tbb' | 'onetbb' | 'openmp')
+        Napi::Value SetParallelBackend(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1 || !info[0].IsString()) {
+                throw Napi::TypeError::New(info.Env(), "期望后端名称字符串参数");
+            }
+
+            // OpenCV 不支持在并行区域执行期间替换后端
+            JobScheduler::Stats stats = JobScheduler::Instance().GetStats();
+            if (stats.running > 0 || stats.queueDepth > 0) {
+                throw Napi::Error::New(info.Env(), "仍有异步任务在执行，不能切换并行后端");
+            }
+
+            std::string name = info[0].As<Napi::String>().Utf8Value();
+            if (!SelectParallelBackend(name)) {
+                throw Napi::Error::New(info.Env(), "并行后端不可用: " + name);
+            }
+            return info.Env().Undefined(); });
+        }
+
+        Napi::Value GetParallelBackend(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return Napi::String::New(info.Env(), CurrentParallelBackend()); });
+        }
+
+        // cpuTopology() 返回 {cpus, nodes: [{id, cpus: [...]}]}，只包含进程允许使用的 CPU
+        Napi::Value GetCpuTopology(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            const CpuTopology &topology = CpuTopology::Get();
+
+            Napi::Array nodes = Napi::Array::New(env, topology.Nodes().size());
+            for (size_t i = 0; i < topology.Nodes().size(); i++) {
+                const NumaNode &node = topology.Nodes()[i];
+                Napi::Array cpus = Napi::Array::New(env, node.cpus.size());
+                for (size_t j = 0; j < node.cpus.size(); j++) {
+                    cpus.Set(static_cast<uint32_t>(j), Napi::Number::New(env, node.cpus[j]));
+                }
+
+                Napi::Object nodeObj = Napi::Object::New(env);
+                nodeObj.Set("id", Napi::Number::New(env, node.id));
+                nodeObj.Set("cpus", cpus);
+                nodes.Set(static_cast<uint32_t>(i), nodeObj);
+            }
+
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("cpus", Napi::Number::New(env, static_cast<double>(topology.Cpus().size())));
+            result.Set("nodes", nodes);
+            return result; });
+        }
+
         // ==================== 占位符实现 ====================
         // 这些函数暂时只抛出"未实现"错误，后续可以逐步实现
 
@@ -64,6 +64,12 @@ namespace Core {
     Napi::Value RNG_Uniform(const Napi::CallbackInfo &info);
     Napi::Value RNG_Gaussian(const Napi::CallbackInfo &info);
 
+    // ==================== 点与矩形数组打包 ====================
+    Napi::Value PackPoints(const Napi::CallbackInfo &info);
+    Napi::Value UnpackPoints(const Napi::CallbackInfo &info);
+    Napi::Value PackRects(const Napi::CallbackInfo &info);
+    Napi::Value UnpackRects(const Napi::CallbackInfo &info);
+
     // ==================== 随机数生成函数 ====================
     Napi::Value Randu(const Napi::CallbackInfo &info);
     Napi::Value Randn(const Napi::CallbackInfo &info);
@@ -123,11 +129,19 @@ namespace Core {
     Napi::Value FastFree(const Napi::CallbackInfo &info);
     Napi::Value SetUseOptimized(const Napi::CallbackInfo &info);
     Napi::Value UseOptimized(const Napi::CallbackInfo &info);
+    Napi::Value BufferPoolStats(const Napi::CallbackInfo &info);
+    Napi::Value BufferPoolConfigure(const Napi::CallbackInfo &info);
+    Napi::Value BufferPoolTrim(const Napi::CallbackInfo &info);
 
     // ==================== 并行处理函数 ====================
     Napi::Value SetNumThreads(const Napi::CallbackInfo &info);
     Napi::Value GetNumThreads(const Napi::CallbackInfo &info);
     Napi::Value GetThreadNum(const Napi::CallbackInfo &info);
+    Napi::Value SchedulerConfigure(const Napi::CallbackInfo &info);
+    Napi::Value SchedulerStats(const Napi::CallbackInfo &info);
+    Napi::Value SetParallelBackend(const Napi::CallbackInfo &info);
+    Napi::Value GetParallelBackend(const Napi::CallbackInfo &info);
+    Napi::Value GetCpuTopology(const Napi::CallbackInfo &info);
 
     // ==================== 错误处理函数 ====================
     Napi::Value SetBreakOnError(const Napi::CallbackInfo &info);
@@ -0,0 +1,84 @@
+#include "compile_cache.h"
+
+namespace NapiOpenCV {
+namespace Gapi {
+
+    CompileCache &CompileCache::Instance()
+    {
+        // 故意不析构：进程退出时 G-API 的内部状态可能已先行销毁
+        static CompileCache *instance = new CompileCache();
+        return *instance;
+    }
+
+    std::shared_ptr<CompiledGraph> CompileCache::GetOrCompile(const std::string &key,
+                                                              const std::function<cv::GCompiled()> &compile)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(key);
+            if (it != index_.end())
+            {
+                stats_.hits++;
+                lru_.splice(lru_.begin(), lru_, it->second);
+                return it->second->second;
+            }
+            stats_.misses++;
+        }
+
+        // 编译可能耗时数毫秒到数百毫秒，不持有缓存锁
+        auto entry = std::make_shared<CompiledGraph>();
+        entry->compiled = compile();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stats_.capacity == 0)
+        {
+            return entry;
+        }
+
+        auto it = index_.find(key);
+        if (it != index_.end())
+        {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->second;
+        }
+
+        lru_.emplace_front(key, entry);
+        index_[key] = lru_.begin();
+        EvictLocked();
+        return entry;
+    }
+
+    void CompileCache::Configure(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.capacity = capacity;
+        EvictLocked();
+    }
+
+    void CompileCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lru_.clear();
+        index_.clear();
+    }
+
+    CompileCache::Stats CompileCache::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.entries = lru_.size();
+        return stats;
+    }
+
+    void CompileCache::EvictLocked()
+    {
+        while (lru_.size() > stats_.capacity)
+        {
+            index_.erase(lru_.back().first);
+            lru_.pop_back();
+            stats_.evictions++;
+        }
+    }
+
+} // namespace Gapi
+} // namespace NapiOpenCV
@@ -0,0 +1,65 @@
+#ifndef NAPI_OPENCV_COMPILE_CACHE_H
+#define NAPI_OPENCV_COMPILE_CACHE_H
+
+#include <opencv2/gapi.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace NapiOpenCV {
+namespace Gapi {
+
+    // 一个编译结果；GCompiled 不可重入，同一结果上的执行串行进行
+    struct CompiledGraph
+    {
+        cv::GCompiled compiled;
+        std::mutex mutex;
+    };
+
+    // 进程级的编译结果缓存，键为 (计算图签名, 输入描述, 内核包)，按 LRU 淘汰
+    // 操作相同的不同 GComputation 共享编译结果；淘汰只移出缓存，正在使用的结果在用完后释放
+    class CompileCache
+    {
+    public:
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            size_t entries = 0;
+            size_t capacity = 0;
+        };
+
+        static CompileCache &Instance();
+
+        // 命中时直接返回；未命中时在锁外调用 compile，并发的同键未命中以先插入者为准
+        std::shared_ptr<CompiledGraph> GetOrCompile(const std::string &key, const std::function<cv::GCompiled()> &compile);
+
+        // capacity 为 0 时不缓存，每次调用都重新编译
+        void Configure(size_t capacity);
+        void Clear();
+        Stats GetStats();
+
+    private:
+        CompileCache() = default;
+
+        void EvictLocked();
+
+        using Entry = std::pair<std::string, std::shared_ptr<CompiledGraph>>;
+
+        std::mutex mutex_;
+        std::list<Entry> lru_; // 最近使用的在前
+        std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+        Stats stats_{0, 0, 0, 0, 64};
+    };
+
+} // namespace Gapi
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_COMPILE_CACHE_H
@@ -1,4 +1,7 @@
 #include "gapi.h"
+#include "compile_cache.h"
+#include "gcomputation.h"
+#include "gstreaming.h"
 #include "../common/safe_call.h"
 #include "../common/type_converters.h"
 
@@ -11,6 +14,9 @@ namespace NapiOpenCV
 
         void RegisterFunctions(Napi::Env env, Napi::Object exports)
         {
+            GComputationWrap::Init(env, exports);
+            GStreamingWrap::Init(env, exports);
+
             exports.Set("gcomputation_create", Napi::Function::New(env, GComputation_Create));
             exports.Set("gcomputation_apply", Napi::Function::New(env, GComputation_Apply));
             exports.Set("gcomputation_applywithargs", Napi::Function::New(env, GComputation_ApplyWithArgs));
@@ -24,10 +30,256 @@ namespace NapiOpenCV
             exports.Set("gapiblur", Napi::Function::New(env, GApiBlur));
             exports.Set("gapicvtcolor", Napi::Function::New(env, GApiCvtColor));
             exports.Set("gapicpu", Napi::Function::New(env, GApiCPU));
+            exports.Set("gapifluid", Napi::Function::New(env, GApiFluid));
             exports.Set("gapiocl", Napi::Function::New(env, GApiOCL));
             exports.Set("gapiie", Napi::Function::New(env, GApiIE));
             exports.Set("gstreamingcompile", Napi::Function::New(env, GStreamingCompile));
             exports.Set("gstreamingapply", Napi::Function::New(env, GStreamingApply));
+            exports.Set("gapiCacheStats", Napi::Function::New(env, GApiCacheStats));
+            exports.Set("gapiCacheConfigure", Napi::Function::New(env, GApiCacheConfigure));
+            exports.Set("gapiCacheClear", Napi::Function::New(env, GApiCacheClear));
+        }
+
+        namespace
+        {
+            GComputationWrap *ExpectComputation(Napi::Env env, Napi::Value value)
+            {
+                GComputationWrap *computation = GComputationWrap::FromValue(value);
+                if (computation == nullptr)
+                {
+                    throw Napi::TypeError::New(env, "期望 GComputation 对象");
+                }
+                return computation;
+            }
+
+            Napi::Object Descriptor(Napi::Env env, const char *op)
+            {
+                Napi::Object object = Napi::Object::New(env);
+                object.Set("op", op);
+                return object;
+            }
+
+            // gapiadd 等函数生成 {op, scalar} 描述
+            Napi::Value ScalarDescriptor(const Napi::CallbackInfo &info, const char *op)
+            {
+                return SafeCall(info.Env(), [&]() -> Napi::Value
+                                {
+                Napi::Env env = info.Env();
+                if (info.Length() < 1 || !(info[0].IsNumber() || info[0].IsArray() || info[0].IsObject())) {
+                    throw Napi::TypeError::New(env, std::string(op) + " 期望数字或 Scalar 参数");
+                }
+                Napi::Object object = Descriptor(env, op);
+                object.Set("scalar", info[0]);
+                return object; });
+            }
+        } // namespace
+
+        // ==================== G-API计算图函数 ====================
+
+        // gcomputation_create(ops)：ops 为 gapi* 函数生成的操作描述数组，按顺序串成单输入单输出的计算图
+        Napi::Value GComputation_Create(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return GComputationWrap::NewInstance(info.Env(), info[0]); });
+        }
+
+        Napi::Value GComputation_Apply(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            return ExpectComputation(env, info[0])->ApplyWith(env, info[1], info[2]); });
+        }
+
+        // gcomputation_applywithargs(g, mat, {kernels})
+        Napi::Value GComputation_ApplyWithArgs(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (info.Length() < 3 || !info[2].IsObject()) {
+                throw Napi::TypeError::New(env, "期望 (computation, mat, args) 参数");
+            }
+            return ExpectComputation(env, info[0])->ApplyWith(env, info[1], info[2]); });
+        }
+
+        Napi::Value GComputation_Compile(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            return ExpectComputation(env, info[0])->CompileWith(env, info[1], info[2]); });
+        }
+
+        // ==================== G-API操作函数 ====================
+
+        Napi::Value GApiAdd(const Napi::CallbackInfo &info)
+        {
+            return ScalarDescriptor(info, "add");
+        }
+
+        Napi::Value GApiSubtract(const Napi::CallbackInfo &info)
+        {
+            return ScalarDescriptor(info, "subtract");
+        }
+
+        Napi::Value GApiMultiply(const Napi::CallbackInfo &info)
+        {
+            return ScalarDescriptor(info, "multiply");
+        }
+
+        Napi::Value GApiDivide(const Napi::CallbackInfo &info)
+        {
+            return ScalarDescriptor(info, "divide");
+        }
+
+        // gapiresize(size[, interpolation]) 或 gapiresize(null, fx, fy[, interpolation])
+        Napi::Value GApiResize(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            Napi::Object object = Descriptor(env, "resize");
+            if (info[0].IsObject()) {
+                object.Set("size", info[0]);
+                if (info[1].IsNumber()) {
+                    object.Set("interpolation", info[1]);
+                }
+            } else if (info[1].IsNumber() && info[2].IsNumber()) {
+                object.Set("fx", info[1]);
+                object.Set("fy", info[2]);
+                if (info[3].IsNumber()) {
+                    object.Set("interpolation", info[3]);
+                }
+            } else {
+                throw Napi::TypeError::New(env, "期望 (size[, interpolation]) 或 (null, fx, fy[, interpolation]) 参数");
+            }
+            return object; });
+        }
+
+        // gapifilter2d(kernel[, ddepth])
+        Napi::Value GApiFilter2D(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(env, "期望 (kernel[, ddepth]) 参数");
+            }
+            Napi::Object object = Descriptor(env, "filter2D");
+            object.Set("kernel", info[0]);
+            object.Set("ddepth", info[1].IsNumber() ? info[1] : Napi::Number::New(env, -1));
+            return object; });
+        }
+
+        // gapiblur(ksize)：ksize 为数字或 {width, height}
+        Napi::Value GApiBlur(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (info.Length() < 1 || !(info[0].IsNumber() || info[0].IsObject())) {
+                throw Napi::TypeError::New(env, "期望 (ksize) 参数");
+            }
+            Napi::Object object = Descriptor(env, "blur");
+            object.Set("ksize", info[0]);
+            return object; });
+        }
+
+        Napi::Value GApiCvtColor(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (info.Length() < 1 || !info[0].IsNumber()) {
+                throw Napi::TypeError::New(env, "期望 (code) 参数");
+            }
+            Napi::Object object = Descriptor(env, "cvtColor");
+            object.Set("code", info[0]);
+            return object; });
+        }
+
+        // ==================== G-API后端函数 ====================
+
+        // 返回可作为 {kernels} 选项的内核包名
+        Napi::Value GApiCPU(const Napi::CallbackInfo &info)
+        {
+            return Napi::String::New(info.Env(), "cpu");
+        }
+
+        Napi::Value GApiFluid(const Napi::CallbackInfo &info)
+        {
+            return Napi::String::New(info.Env(), "fluid");
+        }
+
+        // ==================== G-API流水线函数 ====================
+
+        // gstreamingcompile(g[, {kernels, queueCapacity}])：返回尚未启动的 GStreaming
+        Napi::Value GStreamingCompile(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            ExpectComputation(env, info[0])->State(env);
+            return GStreamingWrap::NewInstance(env, info[0], info[1]); });
+        }
+
+        // gstreamingapply(streaming, source)：接上视频源并启动，返回同一个 GStreaming 供 for await 使用
+        Napi::Value GStreamingApply(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            GStreamingWrap *streaming = GStreamingWrap::FromValue(info[0]);
+            if (streaming == nullptr) {
+                throw Napi::TypeError::New(env, "期望 GStreaming 对象");
+            }
+            streaming->StartWith(env, info[1]);
+            return info[0]; });
+        }
+
+        // ==================== 编译缓存 ====================
+
+        Napi::Value GApiCacheStats(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            CompileCache::Stats stats = CompileCache::Instance().GetStats();
+
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+            result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+            result.Set("evictions", Napi::Number::New(env, static_cast<double>(stats.evictions)));
+            result.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+            result.Set("capacity", Napi::Number::New(env, static_cast<double>(stats.capacity)));
+            return result; });
+        }
+
+        // gapiCacheConfigure({capacity})
+        Napi::Value GApiCacheConfigure(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 1 || !info[0].IsObject()) {
+                throw Napi::TypeError::New(info.Env(), "期望配置对象参数");
+            }
+
+            Napi::Object options = info[0].As<Napi::Object>();
+            if (options.Has("capacity") && options.Get("capacity").IsNumber()) {
+                double value = options.Get("capacity").As<Napi::Number>().DoubleValue();
+                if (value < 0) {
+                    throw Napi::RangeError::New(info.Env(), "capacity 不能为负数");
+                }
+                CompileCache::Instance().Configure(static_cast<size_t>(value));
+            }
+            return info.Env().Undefined(); });
+        }
+
+        Napi::Value GApiCacheClear(const Napi::CallbackInfo &info)
+        {
+            CompileCache::Instance().Clear();
+            return info.Env().Undefined();
         }
 
         // 占位符实现
@@ -38,23 +290,8 @@ namespace NapiOpenCV
         return info.Env().Undefined();                                                         \
     }
 
-        PLACEHOLDER_IMPL(GComputation_Create)
-        PLACEHOLDER_IMPL(GComputation_Apply)
-        PLACEHOLDER_IMPL(GComputation_ApplyWithArgs)
-        PLACEHOLDER_IMPL(GComputation_Compile)
-        PLACEHOLDER_IMPL(GApiAdd)
-        PLACEHOLDER_IMPL(GApiSubtract)
-        PLACEHOLDER_IMPL(GApiMultiply)
-        PLACEHOLDER_IMPL(GApiDivide)
-        PLACEHOLDER_IMPL(GApiResize)
-        PLACEHOLDER_IMPL(GApiFilter2D)
-        PLACEHOLDER_IMPL(GApiBlur)
-        PLACEHOLDER_IMPL(GApiCvtColor)
-        PLACEHOLDER_IMPL(GApiCPU)
         PLACEHOLDER_IMPL(GApiOCL)
         PLACEHOLDER_IMPL(GApiIE)
-        PLACEHOLDER_IMPL(GStreamingCompile)
-        PLACEHOLDER_IMPL(GStreamingApply)
 
     } // namespace Gapi
 } // namespace NapiOpenCV
@@ -27,6 +27,7 @@ namespace Gapi {
 
     // ==================== G-API后端函数 ====================
     Napi::Value GApiCPU(const Napi::CallbackInfo &info);
+    Napi::Value GApiFluid(const Napi::CallbackInfo &info);
     Napi::Value GApiOCL(const Napi::CallbackInfo &info);
     Napi::Value GApiIE(const Napi::CallbackInfo &info);
 
@@ -34,6 +35,12 @@ namespace Gapi {
     Napi::Value GStreamingCompile(const Napi::CallbackInfo &info);
     Napi::Value GStreamingApply(const Napi::CallbackInfo &info);
 
+    // ==================== 编译缓存 ====================
+    // 进程级的编译结果缓存，按 (计算图签名, 输入描述, 内核包) 以 LRU 淘汰
+    Napi::Value GApiCacheStats(const Napi::CallbackInfo &info);
+    Napi::Value GApiCacheConfigure(const Napi::CallbackInfo &info);
+    Napi::Value GApiCacheClear(const Napi::CallbackInfo &info);
+
 } // namespace Gapi
 } // namespace NapiOpenCV
 
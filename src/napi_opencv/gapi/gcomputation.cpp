@@ -0,0 +1,530 @@
+#include "gcomputation.h"
+#include "compile_cache.h"
+#include "gstreaming.h"
+#include "../common/addon_data.h"
+#include "../common/allocator.h"
+#include "../common/async_job.h"
+#include "../common/disposable.h"
+#include "../common/mat_wrap.h"
+#include "../common/safe_call.h"
+#include "../common/type_converters.h"
+#include <opencv2/gapi/core.hpp>
+#include <opencv2/gapi/imgproc.hpp>
+#include <opencv2/gapi/cpu/core.hpp>
+#include <opencv2/gapi/cpu/imgproc.hpp>
+#include <opencv2/gapi/fluid/core.hpp>
+#include <opencv2/gapi/fluid/imgproc.hpp>
+#include <opencv2/imgproc.hpp>
+#include <sstream>
+#include <stdexcept>
+
+using namespace NapiOpenCV::Common;
+
+namespace NapiOpenCV
+{
+    namespace Gapi
+    {
+
+        namespace
+        {
+            Napi::TypeError OpError(Napi::Env env, size_t index, const std::string &message)
+            {
+                return Napi::TypeError::New(env, "第 " + std::to_string(index) + " 个操作: " + message);
+            }
+
+            double NumberField(Napi::Object object, const char *key, double fallback)
+            {
+                Napi::Value value = object.Get(key);
+                return value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : fallback;
+            }
+
+            cv::Size SizeField(Napi::Object object, const char *key)
+            {
+                Napi::Value value = object.Get(key);
+                if (value.IsNumber())
+                {
+                    int k = value.As<Napi::Number>().Int32Value();
+                    return cv::Size(k, k);
+                }
+                return value.IsObject() ? TypeConverter<cv::Size>::FromNapi(value) : cv::Size();
+            }
+
+            // G-API 只提供部分颜色转换，其余代码在构建计算图前报错
+            bool IsSupportedColorCode(int code)
+            {
+                switch (code)
+                {
+                case cv::COLOR_BGR2RGB: // 与 COLOR_RGB2BGR 同值
+                case cv::COLOR_BGR2GRAY:
+                case cv::COLOR_RGB2GRAY:
+                case cv::COLOR_BGR2YUV:
+                case cv::COLOR_RGB2YUV:
+                case cv::COLOR_YUV2BGR:
+                case cv::COLOR_YUV2RGB:
+                case cv::COLOR_BGR2Luv:
+                case cv::COLOR_Luv2BGR:
+                case cv::COLOR_RGB2Lab:
+                case cv::COLOR_RGB2HSV:
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            cv::GMat CvtColor(const cv::GMat &src, int code)
+            {
+                switch (code)
+                {
+                case cv::COLOR_BGR2RGB: // 与 COLOR_RGB2BGR 同值
+                    return cv::gapi::BGR2RGB(src);
+                case cv::COLOR_BGR2GRAY:
+                    return cv::gapi::BGR2Gray(src);
+                case cv::COLOR_RGB2GRAY:
+                    return cv::gapi::RGB2Gray(src);
+                case cv::COLOR_BGR2YUV:
+                    return cv::gapi::BGR2YUV(src);
+                case cv::COLOR_RGB2YUV:
+                    return cv::gapi::RGB2YUV(src);
+                case cv::COLOR_YUV2BGR:
+                    return cv::gapi::YUV2BGR(src);
+                case cv::COLOR_YUV2RGB:
+                    return cv::gapi::YUV2RGB(src);
+                case cv::COLOR_BGR2Luv:
+                    return cv::gapi::BGR2LUV(src);
+                case cv::COLOR_Luv2BGR:
+                    return cv::gapi::LUV2BGR(src);
+                case cv::COLOR_RGB2Lab:
+                    return cv::gapi::RGB2Lab(src);
+                case cv::COLOR_RGB2HSV:
+                    return cv::gapi::RGB2HSV(src);
+                default:
+                    throw std::invalid_argument("G-API 不支持颜色转换代码 " + std::to_string(code));
+                }
+            }
+
+            cv::GMat ApplyOp(const GraphOp &op, const cv::GMat &src)
+            {
+                if (op.op == "resize")
+                {
+                    return cv::gapi::resize(src, op.size, op.fx, op.fy, op.interpolation);
+                }
+                if (op.op == "blur")
+                {
+                    return cv::gapi::blur(src, op.ksize);
+                }
+                if (op.op == "gaussianBlur")
+                {
+                    return cv::gapi::gaussianBlur(src, op.ksize, op.sigmaX, op.sigmaY);
+                }
+                if (op.op == "filter2D")
+                {
+                    return cv::gapi::filter2D(src, op.ddepth, op.kernel);
+                }
+                if (op.op == "cvtColor")
+                {
+                    return CvtColor(src, op.code);
+                }
+                if (op.op == "add")
+                {
+                    return cv::gapi::addC(src, cv::GScalar(op.scalar));
+                }
+                if (op.op == "subtract")
+                {
+                    return cv::gapi::subC(src, cv::GScalar(op.scalar));
+                }
+                if (op.op == "multiply")
+                {
+                    return cv::gapi::mulC(src, cv::GScalar(op.scalar));
+                }
+                if (op.op == "divide")
+                {
+                    return cv::gapi::divC(src, cv::GScalar(op.scalar), 1.0);
+                }
+                throw std::invalid_argument("未知操作 '" + op.op + "'");
+            }
+
+            // cpu 为 OpenCV 函数实现；fluid 按行分块流水执行，中间结果只保留少量行，
+            // combine 时右侧优先，fluid 没有的内核由 cpu 补齐
+            cv::GKernelPackage KernelPackage(const std::string &kernels)
+            {
+                cv::GKernelPackage cpu = cv::gapi::combine(cv::gapi::core::cpu::kernels(),
+                                                           cv::gapi::imgproc::cpu::kernels());
+                if (kernels == "fluid")
+                {
+                    return cv::gapi::combine(cpu, cv::gapi::combine(cv::gapi::core::fluid::kernels(),
+                                                                    cv::gapi::imgproc::fluid::kernels()));
+                }
+                return cpu;
+            }
+
+            std::string CacheKey(const cv::GMatDesc &desc, const std::string &kernels)
+            {
+                return kernels + ":" + std::to_string(desc.depth) + "x" + std::to_string(desc.chan) + ":" +
+                       std::to_string(desc.size.width) + "x" + std::to_string(desc.size.height) +
+                       (desc.planar ? ":planar" : "");
+            }
+
+            // 计算图签名：按顺序写出每个操作的全部参数，filter2D 的核按原始字节写入
+            std::string Signature(const std::vector<GraphOp> &ops)
+            {
+                std::ostringstream out;
+                out.precision(17);
+                for (const GraphOp &op : ops)
+                {
+                    out << op.op << '(' << op.size.width << 'x' << op.size.height << ',' << op.fx << ',' << op.fy << ','
+                        << op.interpolation << ',' << op.ksize.width << 'x' << op.ksize.height << ',' << op.sigmaX << ','
+                        << op.sigmaY << ',' << op.code << ',' << op.ddepth << ',' << op.scalar[0] << ',' << op.scalar[1]
+                        << ',' << op.scalar[2] << ',' << op.scalar[3];
+                    if (!op.kernel.empty())
+                    {
+                        out << ',' << op.kernel.type() << ':' << op.kernel.rows << 'x' << op.kernel.cols << ':';
+                        out.write(reinterpret_cast<const char *>(op.kernel.data), op.kernel.total() * op.kernel.elemSize());
+                    }
+                    out << ')';
+                }
+                return out.str();
+            }
+
+            // 在 JS 线程一次性校验整条链，参数错误在构建计算图前报告
+            std::vector<GraphOp> ParseOps(Napi::Env env, Napi::Value value)
+            {
+                if (!value.IsArray())
+                {
+                    throw Napi::TypeError::New(env, "期望操作数组");
+                }
+
+                Napi::Array array = value.As<Napi::Array>();
+                uint32_t count = array.Length();
+                if (count == 0)
+                {
+                    throw Napi::TypeError::New(env, "计算图至少需要一个操作");
+                }
+
+                std::vector<GraphOp> ops;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    Napi::Value item = array.Get(i);
+                    if (!item.IsObject() || !item.As<Napi::Object>().Get("op").IsString())
+                    {
+                        throw OpError(env, i, "期望 {op, ...} 对象");
+                    }
+
+                    Napi::Object object = item.As<Napi::Object>();
+                    GraphOp op;
+                    op.op = object.Get("op").As<Napi::String>().Utf8Value();
+
+                    if (op.op == "resize")
+                    {
+                        if (object.Get("size").IsObject())
+                        {
+                            op.size = TypeConverter<cv::Size>::FromNapi(object.Get("size"));
+                        }
+                        else
+                        {
+                            op.size.width = static_cast<int>(NumberField(object, "width", 0));
+                            op.size.height = static_cast<int>(NumberField(object, "height", 0));
+                        }
+                        op.fx = NumberField(object, "fx", 0);
+                        op.fy = NumberField(object, "fy", 0);
+                        op.interpolation = static_cast<int>(NumberField(object, "interpolation", cv::INTER_LINEAR));
+                        if (op.size.area() <= 0 && (op.fx <= 0 || op.fy <= 0))
+                        {
+                            throw OpError(env, i, "resize 需要 {width, height}、size 或正数 fx/fy");
+                        }
+                    }
+                    else if (op.op == "blur")
+                    {
+                        op.ksize = SizeField(object, "ksize");
+                        if (op.ksize.area() <= 0)
+                        {
+                            throw OpError(env, i, "blur 需要正数 ksize");
+                        }
+                    }
+                    else if (op.op == "gaussianBlur")
+                    {
+                        op.ksize = SizeField(object, "ksize");
+                        op.sigmaX = NumberField(object, "sigmaX", 0);
+                        op.sigmaY = NumberField(object, "sigmaY", 0);
+                        if (op.ksize.area() <= 0 && op.sigmaX <= 0)
+                        {
+                            throw OpError(env, i, "gaussianBlur 需要 ksize 或正数 sigmaX");
+                        }
+                    }
+                    else if (op.op == "filter2D")
+                    {
+                        if (object.Get("kernel").IsUndefined())
+                        {
+                            throw OpError(env, i, "filter2D 需要 Mat 参数 kernel");
+                        }
+                        // 计算图持有自己的核副本，之后修改 JS 侧的 Mat 不影响已构建的图
+                        op.kernel = TypeConverter<cv::Mat>::FromNapi(object.Get("kernel")).clone();
+                        op.ddepth = static_cast<int>(NumberField(object, "ddepth", -1));
+                    }
+                    else if (op.op == "cvtColor")
+                    {
+                        if (!object.Get("code").IsNumber())
+                        {
+                            throw OpError(env, i, "cvtColor 需要数字参数 code");
+                        }
+                        op.code = object.Get("code").As<Napi::Number>().Int32Value();
+                        if (!IsSupportedColorCode(op.code))
+                        {
+                            throw OpError(env, i, "G-API 不支持颜色转换代码 " + std::to_string(op.code));
+                        }
+                    }
+                    else if (op.op == "add" || op.op == "subtract" || op.op == "multiply" || op.op == "divide")
+                    {
+                        Napi::Value scalar = object.Get("scalar");
+                        if (scalar.IsNumber())
+                        {
+                            double v = scalar.As<Napi::Number>().DoubleValue();
+                            // 乘除的标量作用于每个通道
+                            op.scalar = op.op == "multiply" || op.op == "divide" ? cv::Scalar::all(v) : cv::Scalar(v);
+                        }
+                        else if (scalar.IsArray() || scalar.IsObject())
+                        {
+                            op.scalar = TypeConverter<cv::Scalar>::FromNapi(scalar);
+                        }
+                        else
+                        {
+                            throw OpError(env, i, op.op + " 需要参数 scalar");
+                        }
+                    }
+                    else
+                    {
+                        throw OpError(env, i, "未知操作 '" + op.op + "'");
+                    }
+
+                    ops.push_back(op);
+                }
+                return ops;
+            }
+
+            // compile() 接受 Mat 或 {rows, cols, type} 描述
+            cv::GMatDesc ParseMeta(Napi::Env env, Napi::Value value)
+            {
+                if (MatWrap::IsInstance(value))
+                {
+                    return cv::descr_of(TypeConverter<cv::Mat>::FromNapi(value));
+                }
+
+                if (value.IsObject())
+                {
+                    Napi::Object object = value.As<Napi::Object>();
+                    if (object.Get("rows").IsNumber() && object.Get("cols").IsNumber() && object.Get("type").IsNumber())
+                    {
+                        int type = object.Get("type").As<Napi::Number>().Int32Value();
+                        return cv::GMatDesc(CV_MAT_DEPTH(type), CV_MAT_CN(type),
+                                            cv::Size(object.Get("cols").As<Napi::Number>().Int32Value(),
+                                                     object.Get("rows").As<Napi::Number>().Int32Value()));
+                    }
+                }
+
+                throw Napi::TypeError::New(env, "期望 Mat 或 {rows, cols, type} 输入描述");
+            }
+        } // namespace
+
+        // 最后一个参数为普通对象时读取其中的 kernels
+        std::string ParseKernels(Napi::Env env, Napi::Value options)
+        {
+            if (!options.IsObject() || MatWrap::IsInstance(options))
+            {
+                return "cpu";
+            }
+
+            Napi::Value kernels = options.As<Napi::Object>().Get("kernels");
+            if (kernels.IsUndefined())
+            {
+                return "cpu";
+            }
+
+            std::string name = kernels.IsString() ? kernels.As<Napi::String>().Utf8Value() : std::string();
+            if (!GraphState::IsKnownKernels(name))
+            {
+                throw Napi::TypeError::New(env, "kernels 必须是 'cpu' 或 'fluid'");
+            }
+            return name;
+        }
+
+        // ==================== 计算图状态 ====================
+
+        GraphState::GraphState(const std::vector<GraphOp> &ops)
+            : signature_(Signature(ops)),
+              computation_([&ops]()
+                           {
+                cv::GMat in;
+                cv::GMat out = in;
+                for (const GraphOp &op : ops) {
+                    out = ApplyOp(op, out);
+                }
+                return cv::GComputation(cv::GIn(in), cv::GOut(out)); })
+        {
+        }
+
+        bool GraphState::IsKnownKernels(const std::string &kernels)
+        {
+            return kernels == "cpu" || kernels == "fluid";
+        }
+
+        std::shared_ptr<CompiledGraph> GraphState::CompiledFor(const cv::GMatDesc &desc, const std::string &kernels)
+        {
+            return CompileCache::Instance().GetOrCompile(signature_ + "|" + CacheKey(desc, kernels), [&]()
+                                                         {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return computation_.compile(cv::GMetaArgs{cv::GMetaArg(desc)}, cv::compile_args(KernelPackage(kernels))); });
+        }
+
+        cv::Mat GraphState::Apply(const cv::Mat &input, const std::string &kernels)
+        {
+            std::shared_ptr<CompiledGraph> entry = CompiledFor(cv::descr_of(input), kernels);
+            cv::Mat output = NewOutputMat();
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            entry->compiled(cv::gin(input), cv::gout(output));
+            return output;
+        }
+
+        void GraphState::Compile(const cv::GMatDesc &desc, const std::string &kernels)
+        {
+            CompiledFor(desc, kernels);
+        }
+
+        cv::GStreamingCompiled GraphState::CompileStreaming(const std::string &kernels, size_t queueCapacity)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return computation_.compileStreaming(cv::compile_args(KernelPackage(kernels),
+                                                                  cv::gapi::streaming::queue_capacity(queueCapacity)));
+        }
+
+        // ==================== GComputation 句柄 ====================
+
+        void GComputationWrap::Init(Napi::Env env, Napi::Object exports)
+        {
+            Napi::Function func = DefineClass(env, "GComputation", {
+                InstanceMethod("apply", &GComputationWrap::Apply),
+                InstanceMethod("applyAsync", &GComputationWrap::ApplyAsync),
+                InstanceMethod("compile", &GComputationWrap::Compile),
+                InstanceMethod("stream", &GComputationWrap::Stream),
+                InstanceAccessor("isReleased", &GComputationWrap::GetIsReleased, nullptr),
+                InstanceMethod("release", &GComputationWrap::Release),
+            });
+            DefineDispose(env, func);
+
+            GetAddonData(env)->gcomputationConstructor = Napi::Persistent(func);
+
+            exports.Set("GComputation", func);
+        }
+
+        Napi::Object GComputationWrap::NewInstance(Napi::Env env, Napi::Value ops)
+        {
+            return GetAddonData(env)->gcomputationConstructor.New({ops});
+        }
+
+        GComputationWrap *GComputationWrap::FromValue(Napi::Value value)
+        {
+            if (!value.IsObject() ||
+                !value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env())->gcomputationConstructor.Value()))
+            {
+                return nullptr;
+            }
+            return Napi::ObjectWrap<GComputationWrap>::Unwrap(value.As<Napi::Object>());
+        }
+
+        GComputationWrap::GComputationWrap(const Napi::CallbackInfo &info)
+            : Napi::ObjectWrap<GComputationWrap>(info)
+        {
+            Napi::Env env = info.Env();
+            try
+            {
+                state_ = std::make_shared<GraphState>(ParseOps(env, info[0]));
+            }
+            catch (const Napi::Error &e)
+            {
+                e.ThrowAsJavaScriptException();
+            }
+            catch (const cv::Exception &e)
+            {
+                Napi::Error::New(env, "OpenCV 错误: " + std::string(e.what())).ThrowAsJavaScriptException();
+            }
+            catch (const std::exception &e)
+            {
+                Napi::Error::New(env, "错误: " + std::string(e.what())).ThrowAsJavaScriptException();
+            }
+        }
+
+        const std::shared_ptr<GraphState> &GComputationWrap::State(Napi::Env env) const
+        {
+            if (!state_)
+            {
+                throw Napi::Error::New(env, "GComputation 已释放");
+            }
+            return state_;
+        }
+
+        Napi::Value GComputationWrap::ApplyWith(Napi::Env env, Napi::Value input, Napi::Value options)
+        {
+            const std::shared_ptr<GraphState> &state = State(env);
+            cv::Mat mat = TypeConverter<cv::Mat>::FromNapi(input);
+            return TypeConverter<cv::Mat>::ToNapi(env, state->Apply(mat, ParseKernels(env, options)));
+        }
+
+        Napi::Value GComputationWrap::CompileWith(Napi::Env env, Napi::Value meta, Napi::Value options)
+        {
+            State(env)->Compile(ParseMeta(env, meta), ParseKernels(env, options));
+            return env.Undefined();
+        }
+
+        // apply(mat[, {kernels}])：首次遇到的输入描述会先编译，之后复用编译结果
+        Napi::Value GComputationWrap::Apply(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return ApplyWith(info.Env(), info[0], info[1]); });
+        }
+
+        // applyAsync(mat[, {kernels, threads, priority, signal}])：编译与执行都在工作线程中进行
+        Napi::Value GComputationWrap::ApplyAsync(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            std::shared_ptr<GraphState> state = State(env);
+            cv::Mat input = TypeConverter<cv::Mat>::FromNapi(info[0]);
+            std::string kernels = ParseKernels(env, info[1]);
+            return QueueMatJob(env, PinArgs(info), ParseJobOptions(info, 1),
+                               [state, input, kernels]()
+                               { return state->Apply(input, kernels); }); });
+        }
+
+        // compile(matOrMeta[, {kernels}])：提前为给定输入描述编译，避免首次 apply 的编译延迟
+        Napi::Value GComputationWrap::Compile(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return CompileWith(info.Env(), info[0], info[1]); });
+        }
+
+        // stream(source[, {kernels, queueCapacity}])：等价于 gstreamingcompile 后 gstreamingapply
+        Napi::Value GComputationWrap::Stream(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            State(env);
+            Napi::Object streaming = GStreamingWrap::NewInstance(env, info.This(), info[1]);
+            GStreamingWrap::FromValue(streaming)->StartWith(env, info[0]);
+            return streaming; });
+        }
+
+        Napi::Value GComputationWrap::GetIsReleased(const Napi::CallbackInfo &info)
+        {
+            return Napi::Boolean::New(info.Env(), !state_);
+        }
+
+        // 立即释放计算图，不必等待 GC；重复调用无副作用。进程级缓存中的编译结果按 LRU 淘汰，
+        // 不随之移除：操作相同的其他计算图仍可复用，可用 gapiCacheClear() 清空
+        Napi::Value GComputationWrap::Release(const Napi::CallbackInfo &info)
+        {
+            state_.reset();
+            return info.Env().Undefined();
+        }
+
+    } // namespace Gapi
+} // namespace NapiOpenCV
@@ -0,0 +1,94 @@
+#ifndef NAPI_OPENCV_GCOMPUTATION_H
+#define NAPI_OPENCV_GCOMPUTATION_H
+
+#include <napi.h>
+#include <opencv2/gapi.hpp>
+#include <opencv2/imgproc.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Gapi {
+
+    // 计算图中的一个操作，由 JS 的 {op, ...} 描述对象解析而来
+    struct GraphOp
+    {
+        std::string op;
+        cv::Size size;                        // resize
+        double fx = 0;                        // resize
+        double fy = 0;                        // resize
+        int interpolation = cv::INTER_LINEAR; // resize
+        cv::Size ksize;                       // blur / gaussianBlur
+        double sigmaX = 0;                    // gaussianBlur
+        double sigmaY = 0;                    // gaussianBlur
+        int code = 0;                         // cvtColor
+        int ddepth = -1;                      // filter2D
+        cv::Mat kernel;                       // filter2D
+        cv::Scalar scalar;                    // add / subtract / multiply / divide
+    };
+
+    struct CompiledGraph;
+
+    // 单输入单输出的线性计算图，编译结果存放在进程级的 CompileCache 中；可在工作线程中使用
+    class GraphState
+    {
+    public:
+        explicit GraphState(const std::vector<GraphOp> &ops);
+
+        // 按需编译后执行；同一编译结果上的调用串行进行，不同输入描述可并行
+        cv::Mat Apply(const cv::Mat &input, const std::string &kernels);
+        void Compile(const cv::GMatDesc &desc, const std::string &kernels);
+        // 流式编译不绑定输入描述，描述在 setSource 时由视频源给出
+        cv::GStreamingCompiled CompileStreaming(const std::string &kernels, size_t queueCapacity);
+
+        // kernels 为 "cpu" 或 "fluid"，fluid 缺少的内核回退到 cpu
+        static bool IsKnownKernels(const std::string &kernels);
+
+    private:
+        std::shared_ptr<CompiledGraph> CompiledFor(const cv::GMatDesc &desc, const std::string &kernels);
+
+        // 操作相同的计算图签名相同，共享编译结果
+        std::string signature_;
+        cv::GComputation computation_;
+        // 保护 computation_ 的编译
+        std::mutex mutex_;
+    };
+
+    // 选项对象中的 kernels，缺省为 "cpu"
+    std::string ParseKernels(Napi::Env env, Napi::Value options);
+
+    // JS 侧的 GComputation 句柄
+    class GComputationWrap : public Napi::ObjectWrap<GComputationWrap>
+    {
+    public:
+        static void Init(Napi::Env env, Napi::Object exports);
+        static Napi::Object NewInstance(Napi::Env env, Napi::Value ops);
+        static GComputationWrap *FromValue(Napi::Value value);
+
+        GComputationWrap(const Napi::CallbackInfo &info);
+
+        // 供实例方法与 gcomputation_* 函数共用
+        Napi::Value ApplyWith(Napi::Env env, Napi::Value input, Napi::Value options);
+        Napi::Value CompileWith(Napi::Env env, Napi::Value meta, Napi::Value options);
+
+        // 已释放时抛出 Napi::Error
+        const std::shared_ptr<GraphState> &State(Napi::Env env) const;
+
+    private:
+        Napi::Value Apply(const Napi::CallbackInfo &info);
+        Napi::Value ApplyAsync(const Napi::CallbackInfo &info);
+        Napi::Value Compile(const Napi::CallbackInfo &info);
+        Napi::Value Stream(const Napi::CallbackInfo &info);
+        Napi::Value GetIsReleased(const Napi::CallbackInfo &info);
+        Napi::Value Release(const Napi::CallbackInfo &info);
+
+        // release() 后为空；已提交的 applyAsync 与已创建的 GStreaming 各自持有一份
+        std::shared_ptr<GraphState> state_;
+    };
+
+} // namespace Gapi
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_GCOMPUTATION_H
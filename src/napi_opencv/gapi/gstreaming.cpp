@@ -0,0 +1,466 @@
+#include "gstreaming.h"
+#include "../common/addon_data.h"
+#include "../common/disposable.h"
+#include "../common/job_scheduler.h"
+#include "../common/mat_wrap.h"
+#include "../common/safe_call.h"
+#include <opencv2/gapi/streaming/cap.hpp>
+#include <stdexcept>
+
+using namespace NapiOpenCV::Common;
+
+namespace NapiOpenCV
+{
+    namespace Gapi
+    {
+
+        namespace
+        {
+            // 异步迭代器协议的 {value, done}
+            Napi::Object IterResult(Napi::Env env, Napi::Value value, bool done)
+            {
+                Napi::Object result = Napi::Object::New(env);
+                result.Set("value", value);
+                result.Set("done", Napi::Boolean::New(env, done));
+                return result;
+            }
+
+            StreamSource ParseSource(Napi::Env env, Napi::Value value)
+            {
+                StreamSource source;
+                if (value.IsString())
+                {
+                    source.path = value.As<Napi::String>().Utf8Value();
+                }
+                else if (value.IsNumber())
+                {
+                    source.camera = value.As<Napi::Number>().Int32Value();
+                }
+                else
+                {
+                    throw Napi::TypeError::New(env, "期望视频文件路径或摄像头序号");
+                }
+                return source;
+            }
+        } // namespace
+
+        // 一次 next() 请求：Execute 在拉取线程中取下一帧，Complete 回到 JS 线程 resolve
+        class FrameJob : public Job
+        {
+        public:
+            FrameJob(Napi::Env env, std::shared_ptr<StreamState> state)
+                : deferred_(Napi::Promise::Deferred::New(env)), state_(std::move(state))
+            {
+            }
+
+            Napi::Promise Promise() const { return deferred_.Promise(); }
+
+            // 流已结束或已停止，不再拉取
+            void Finish() { more_ = false; }
+
+            void Fail(const std::string &message) override
+            {
+                error_ = message;
+                more_ = false;
+            }
+
+            bool More() const { return more_; }
+
+            void Execute() override
+            {
+                try
+                {
+                    more_ = state_->Pull(frame_);
+                }
+                catch (const cv::Exception &e)
+                {
+                    Fail("OpenCV 错误: " + std::string(e.what()));
+                }
+                catch (const std::exception &e)
+                {
+                    Fail("错误: " + std::string(e.what()));
+                }
+            }
+
+            void Complete(Napi::Env env) override
+            {
+                Napi::HandleScope scope(env);
+                if (!error_.empty())
+                {
+                    deferred_.Reject(Napi::Error::New(env, error_).Value());
+                    return;
+                }
+                deferred_.Resolve(IterResult(env, more_ ? MatWrap::NewInstance(env, frame_) : env.Undefined(), !more_));
+            }
+
+            void Discard() override {}
+
+        private:
+            Napi::Promise::Deferred deferred_;
+            std::shared_ptr<StreamState> state_;
+            cv::Mat frame_;
+            bool more_ = true;
+            std::string error_;
+        };
+
+        namespace
+        {
+            // 一次 release()：拉取线程退出后回到 JS 线程 resolve
+            class ReleaseJob : public Job
+            {
+            public:
+                explicit ReleaseJob(Napi::Env env) : deferred_(Napi::Promise::Deferred::New(env)) {}
+
+                Napi::Promise Promise() const { return deferred_.Promise(); }
+
+                void Execute() override {}
+                void Fail(const std::string &) override {}
+                void Discard() override {}
+
+                void Complete(Napi::Env env) override
+                {
+                    Napi::HandleScope scope(env);
+                    deferred_.Resolve(env.Undefined());
+                }
+
+            private:
+                Napi::Promise::Deferred deferred_;
+            };
+        } // namespace
+
+        // ==================== 流式运行状态 ====================
+
+        StreamState::StreamState(std::shared_ptr<GraphState> graph, std::string kernels, size_t queueCapacity)
+            : graph_(std::move(graph)), kernels_(std::move(kernels)), queueCapacity_(queueCapacity)
+        {
+        }
+
+        void StreamState::Start(const std::shared_ptr<StreamState> &self, const StreamSource &source,
+                                std::shared_ptr<EnvJobQueue> queue)
+        {
+            started_ = true;
+            queue_ = std::move(queue);
+            // 线程持有 self，句柄被回收后仍会处理完已提交的请求再退出
+            thread_ = std::thread([self, source]()
+                                  { self->Run(source); });
+        }
+
+        bool StreamState::Request(FrameJob *job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_)
+                {
+                    return false;
+                }
+                pending_.push_back(job);
+            }
+            wakeup_.notify_one();
+            return true;
+        }
+
+        void StreamState::Stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            wakeup_.notify_one();
+        }
+
+        bool StreamState::WhenStopped(Job *job)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!started_ || exited_)
+            {
+                return false;
+            }
+            stopWaiters_.push_back(job);
+            return true;
+        }
+
+        void StreamState::Detach()
+        {
+            if (thread_.joinable())
+            {
+                thread_.detach();
+            }
+        }
+
+        bool StreamState::Pull(cv::Mat &frame)
+        {
+            return compiled_.pull(cv::gout(frame));
+        }
+
+        void StreamState::Run(StreamSource source)
+        {
+            // 打开视频源可能较慢（读取首帧以得到输入描述），放在拉取线程中；失败时由后续的 next() 报告
+            std::string startError;
+            try
+            {
+                compiled_ = graph_->CompileStreaming(kernels_, queueCapacity_);
+                cv::gapi::wip::IStreamSource::Ptr src =
+                    source.camera >= 0 ? cv::gapi::wip::make_src<cv::gapi::wip::GCaptureSource>(source.camera)
+                                       : cv::gapi::wip::make_src<cv::gapi::wip::GCaptureSource>(source.path);
+                compiled_.setSource(cv::gin(src));
+                compiled_.start();
+            }
+            catch (const cv::Exception &e)
+            {
+                startError = "OpenCV 错误: " + std::string(e.what());
+            }
+            catch (const std::exception &e)
+            {
+                startError = "错误: " + std::string(e.what());
+            }
+
+            bool finished = false;
+            while (true)
+            {
+                FrameJob *job = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    wakeup_.wait(lock, [this]()
+                                 { return stopping_ || !pending_.empty(); });
+                    if (pending_.empty())
+                    {
+                        break;
+                    }
+                    job = pending_.front();
+                    pending_.pop_front();
+                    finished = finished || stopping_;
+                }
+
+                if (!startError.empty())
+                {
+                    job->Fail(startError);
+                    startError.clear();
+                    finished = true;
+                }
+                else if (finished)
+                {
+                    job->Finish();
+                }
+                else
+                {
+                    job->Execute();
+                    finished = !job->More();
+                }
+
+                // 流结束后不再接受请求，线程处理完剩余请求后退出
+                if (finished)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                queue_->Post(job);
+            }
+
+            if (compiled_ && compiled_.running())
+            {
+                compiled_.stop();
+            }
+
+            std::vector<Job *> waiters;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                exited_ = true;
+                waiters.swap(stopWaiters_);
+            }
+            for (Job *job : waiters)
+            {
+                queue_->Post(job);
+            }
+        }
+
+        // ==================== GStreaming 句柄 ====================
+
+        void GStreamingWrap::Init(Napi::Env env, Napi::Object exports)
+        {
+            Napi::Function func = DefineClass(env, "GStreaming", {
+                InstanceMethod("start", &GStreamingWrap::Start),
+                InstanceMethod("next", &GStreamingWrap::Next),
+                InstanceMethod("return", &GStreamingWrap::Return),
+                InstanceMethod("stop", &GStreamingWrap::Stop),
+                InstanceAccessor("isReleased", &GStreamingWrap::GetIsReleased, nullptr),
+                InstanceMethod("release", &GStreamingWrap::Release),
+            });
+            DefineDispose(env, func);
+            DefineAsyncDispose(env, func);
+
+            // [Symbol.asyncIterator]() 返回自身，for await 直接调用 next()
+            Napi::Object prototype = func.Get("prototype").As<Napi::Object>();
+            prototype.Set(Napi::Symbol::WellKnown(env, "asyncIterator"),
+                          Napi::Function::New(env, [](const Napi::CallbackInfo &info) -> Napi::Value
+                                              { return info.This(); }));
+
+            GetAddonData(env)->gstreamingConstructor = Napi::Persistent(func);
+
+            exports.Set("GStreaming", func);
+        }
+
+        Napi::Object GStreamingWrap::NewInstance(Napi::Env env, Napi::Value computation, Napi::Value options)
+        {
+            return GetAddonData(env)->gstreamingConstructor.New({computation, options});
+        }
+
+        GStreamingWrap *GStreamingWrap::FromValue(Napi::Value value)
+        {
+            if (!value.IsObject() ||
+                !value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env())->gstreamingConstructor.Value()))
+            {
+                return nullptr;
+            }
+            return Napi::ObjectWrap<GStreamingWrap>::Unwrap(value.As<Napi::Object>());
+        }
+
+        // new GStreaming(computation[, {kernels, queueCapacity}])
+        GStreamingWrap::GStreamingWrap(const Napi::CallbackInfo &info)
+            : Napi::ObjectWrap<GStreamingWrap>(info)
+        {
+            Napi::Env env = info.Env();
+            try
+            {
+                GComputationWrap *computation = GComputationWrap::FromValue(info[0]);
+                if (computation == nullptr)
+                {
+                    throw Napi::TypeError::New(env, "期望 GComputation 对象");
+                }
+
+                // queueCapacity 为各段之间可缓存的帧数，越大越能吸收单帧耗时的波动，也占用更多内存
+                size_t queueCapacity = 1;
+                if (info[1].IsObject() && info[1].As<Napi::Object>().Get("queueCapacity").IsNumber())
+                {
+                    int capacity = info[1].As<Napi::Object>().Get("queueCapacity").As<Napi::Number>().Int32Value();
+                    if (capacity < 1)
+                    {
+                        throw Napi::RangeError::New(env, "queueCapacity 必须为正整数");
+                    }
+                    queueCapacity = static_cast<size_t>(capacity);
+                }
+
+                state_ = std::make_shared<StreamState>(computation->State(env), ParseKernels(env, info[1]), queueCapacity);
+            }
+            catch (const Napi::Error &e)
+            {
+                e.ThrowAsJavaScriptException();
+            }
+            catch (const std::exception &e)
+            {
+                Napi::Error::New(env, "错误: " + std::string(e.what())).ThrowAsJavaScriptException();
+            }
+        }
+
+        GStreamingWrap::~GStreamingWrap()
+        {
+            // 句柄被回收时停止流水线，拉取线程在处理完已提交的请求后退出
+            if (state_)
+            {
+                state_->Stop();
+                state_->Detach();
+            }
+        }
+
+        void GStreamingWrap::StartWith(Napi::Env env, Napi::Value source)
+        {
+            if (!state_)
+            {
+                throw Napi::Error::New(env, "GStreaming 已释放");
+            }
+            if (state_->Started())
+            {
+                throw Napi::Error::New(env, "GStreaming 已经启动");
+            }
+            state_->Start(state_, ParseSource(env, source), EnvJobQueue::ForEnv(env));
+        }
+
+        // start(source)：source 为视频文件路径（包括 MJPEG、'img_%04d.jpg' 形式的图像序列）或摄像头序号
+        Napi::Value GStreamingWrap::Start(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            StartWith(info.Env(), info[0]);
+            return info.This(); });
+        }
+
+        // next()：返回 Promise<{value: Mat, done: false}>，流结束或已停止后为 {value: undefined, done: true}
+        Napi::Value GStreamingWrap::Next(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (state_ && !state_->Started()) {
+                throw Napi::Error::New(env, "GStreaming 尚未启动，先调用 start(source)");
+            }
+
+            auto *job = new FrameJob(env, state_);
+            Napi::Promise promise = job->Promise();
+            if (!state_ || !state_->Request(job)) {
+                // 已停止或已结束，直接完成
+                job->Finish();
+                job->Complete(env);
+                delete job;
+                return promise;
+            }
+
+            // 等待期间保持事件循环存活，结果经由本 env 的任务完成通道送回
+            EnvJobQueue::ForEnv(env)->BeginJob(env);
+            return promise; });
+        }
+
+        // return()：for await 提前退出（break、异常）时由运行时调用，停止流水线
+        Napi::Value GStreamingWrap::Return(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (state_) {
+                state_->Stop();
+            }
+            Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+            deferred.Resolve(IterResult(env, info[0].IsUndefined() ? env.Undefined() : info[0], true));
+            return deferred.Promise(); });
+        }
+
+        Napi::Value GStreamingWrap::Stop(const Napi::CallbackInfo &info)
+        {
+            if (state_)
+            {
+                state_->Stop();
+            }
+            return info.Env().Undefined();
+        }
+
+        Napi::Value GStreamingWrap::GetIsReleased(const Napi::CallbackInfo &info)
+        {
+            return Napi::Boolean::New(info.Env(), !state_);
+        }
+
+        // 立即释放句柄并停止流水线，返回 Promise：拉取线程处理完已提交的 next() 并停止 G-API 的解码与计算线程后 resolve。
+        // 正在进行的一次拉取可能等待很久（如摄像头无新帧），不在 JS 线程等待；重复调用返回已 resolve 的 Promise
+        Napi::Value GStreamingWrap::Release(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            auto *job = new ReleaseJob(env);
+            Napi::Promise promise = job->Promise();
+            if (state_) {
+                state_->Stop();
+                state_->Detach();
+                if (state_->WhenStopped(job)) {
+                    EnvJobQueue::ForEnv(env)->BeginJob(env);
+                    job = nullptr;
+                }
+                state_.reset();
+            }
+
+            if (job != nullptr) {
+                job->Complete(env);
+                delete job;
+            }
+            return promise; });
+        }
+
+    } // namespace Gapi
+} // namespace NapiOpenCV
@@ -0,0 +1,102 @@
+#ifndef NAPI_OPENCV_GSTREAMING_H
+#define NAPI_OPENCV_GSTREAMING_H
+
+#include <napi.h>
+#include "gcomputation.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NapiOpenCV {
+namespace Common {
+    class EnvJobQueue;
+    class Job;
+}
+
+namespace Gapi {
+
+    class FrameJob;
+
+    // 视频源：文件路径（视频、MJPEG、图像序列模式）或摄像头序号
+    struct StreamSource
+    {
+        std::string path;
+        int camera = -1;
+    };
+
+    // 一条流式计算图的运行状态。GStreamingCompiled 只在专用的拉取线程中使用：
+    // 解码、计算图各段与输出由 G-API 自己的线程流水执行，拉取线程只在 JS 请求下一帧时 pull
+    class StreamState
+    {
+    public:
+        StreamState(std::shared_ptr<GraphState> graph, std::string kernels, size_t queueCapacity);
+
+        // 以下方法只能在 JS 线程调用
+        void Start(const std::shared_ptr<StreamState> &self, const StreamSource &source,
+                   std::shared_ptr<Common::EnvJobQueue> queue);
+        // 已停止或流已结束时返回 false，请求不会入队
+        bool Request(FrameJob *job);
+        void Stop();
+        // 拉取线程处理完已提交的请求并停止 G-API 流水线后，经由 env 的任务完成通道送回 job；
+        // 线程未启动或已退出时返回 false，job 仍归调用方所有
+        bool WhenStopped(Common::Job *job);
+        // 不阻塞 JS 线程，线程持有 self，退出时释放
+        void Detach();
+        bool Started() const { return started_; }
+
+        // 拉取线程调用；流结束时返回 false
+        bool Pull(cv::Mat &frame);
+
+    private:
+        void Run(StreamSource source);
+
+        std::shared_ptr<GraphState> graph_;
+        std::string kernels_;
+        size_t queueCapacity_;
+        std::shared_ptr<Common::EnvJobQueue> queue_;
+        cv::GStreamingCompiled compiled_;
+        bool started_ = false;
+        std::thread thread_;
+
+        std::mutex mutex_;
+        std::condition_variable wakeup_;
+        std::deque<FrameJob *> pending_;
+        bool stopping_ = false;
+        bool exited_ = false;
+        std::vector<Common::Job *> stopWaiters_;
+    };
+
+    // JS 侧的 GStreaming 句柄，同时是异步迭代器：for await (const frame of streaming) { ... }
+    class GStreamingWrap : public Napi::ObjectWrap<GStreamingWrap>
+    {
+    public:
+        static void Init(Napi::Env env, Napi::Object exports);
+        static Napi::Object NewInstance(Napi::Env env, Napi::Value computation, Napi::Value options);
+        static GStreamingWrap *FromValue(Napi::Value value);
+
+        GStreamingWrap(const Napi::CallbackInfo &info);
+        ~GStreamingWrap();
+
+        // 供实例方法与 gstreamingapply 共用
+        void StartWith(Napi::Env env, Napi::Value source);
+
+    private:
+        Napi::Value Start(const Napi::CallbackInfo &info);
+        Napi::Value Next(const Napi::CallbackInfo &info);
+        Napi::Value Return(const Napi::CallbackInfo &info);
+        Napi::Value Stop(const Napi::CallbackInfo &info);
+        Napi::Value GetIsReleased(const Napi::CallbackInfo &info);
+        Napi::Value Release(const Napi::CallbackInfo &info);
+
+        // release() 后为空
+        std::shared_ptr<StreamState> state_;
+    };
+
+} // namespace Gapi
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_GSTREAMING_H
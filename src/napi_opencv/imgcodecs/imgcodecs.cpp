@@ -1,7 +1,11 @@
 #include "imgcodecs.h"
+#include "../common/allocator.h"
+#include "../common/async_job.h"
 #include "../common/safe_call.h"
 #include "../common/type_converters.h"
 #include <opencv2/imgcodecs.hpp>
+#include <memory>
+#include <stdexcept>
 
 using namespace NapiOpenCV::Common;
 
@@ -13,7 +17,9 @@ namespace NapiOpenCV
         void RegisterFunctions(Napi::Env env, Napi::Object exports)
         {
             exports.Set("imread", Napi::Function::New(env, Imread));
+            exports.Set("imreadAsync", Napi::Function::New(env, ImreadAsync));
             exports.Set("imwrite", Napi::Function::New(env, Imwrite));
+            exports.Set("imwriteAsync", Napi::Function::New(env, ImwriteAsync));
             exports.Set("imdecode", Napi::Function::New(env, Imdecode));
             exports.Set("imencode", Napi::Function::New(env, Imencode));
             exports.Set("haveImageReader", Napi::Function::New(env, HaveImageReader));
@@ -24,46 +30,109 @@ namespace NapiOpenCV
             exports.Set("imwriteMulti", Napi::Function::New(env, ImwriteMulti));
         }
 
+        namespace
+        {
+            struct ImreadArgs
+            {
+                std::string filename;
+                int flags = cv::IMREAD_COLOR; // 默认彩色模式
+            };
+
+            ImreadArgs ParseImreadArgs(const Napi::CallbackInfo &info)
+            {
+                if (info.Length() < 1 || !info[0].IsString())
+                {
+                    throw Napi::TypeError::New(info.Env(), "期望字符串参数");
+                }
+
+                ImreadArgs args;
+                args.filename = info[0].As<Napi::String>().Utf8Value();
+                if (info.Length() > 1 && info[1].IsNumber())
+                {
+                    args.flags = info[1].As<Napi::Number>().Int32Value();
+                }
+                return args;
+            }
+
+            // 读取失败时返回空 Mat，由同步与异步调用各自报告错误
+            cv::Mat RunImread(const ImreadArgs &args)
+            {
+                cv::Mat image = NewOutputMat();
+                cv::imread(args.filename, image, args.flags);
+                return image;
+            }
+
+            struct ImwriteArgs
+            {
+                std::string filename;
+                cv::Mat image;
+            };
+
+            ImwriteArgs ParseImwriteArgs(const Napi::CallbackInfo &info)
+            {
+                if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject())
+                {
+                    throw Napi::TypeError::New(info.Env(), "期望字符串和 Mat 对象参数");
+                }
+
+                ImwriteArgs args;
+                args.filename = info[0].As<Napi::String>().Utf8Value();
+                args.image = TypeConverter<cv::Mat>::FromNapi(info[1]);
+                return args;
+            }
+        } // namespace
+
         // 读取图像
         Napi::Value Imread(const Napi::CallbackInfo &info)
         {
             return SafeCall(info.Env(), [&]() -> Napi::Value
                             {
-            if (info.Length() < 1 || !info[0].IsString()) {
-                throw Napi::TypeError::New(info.Env(), "期望字符串参数");
-            }
-            
-            std::string filename = info[0].As<Napi::String>().Utf8Value();
-            int flags = cv::IMREAD_COLOR; // 默认彩色模式
-            
-            if (info.Length() > 1 && info[1].IsNumber()) {
-                flags = info[1].As<Napi::Number>().Int32Value();
-            }
-            
-            cv::Mat image = cv::imread(filename, flags);
+            ImreadArgs args = ParseImreadArgs(info);
+            cv::Mat image = RunImread(args);
             if (image.empty()) {
-                throw Napi::Error::New(info.Env(), "无法读取图像: " + filename);
+                throw Napi::Error::New(info.Env(), "无法读取图像: " + args.filename);
             }
-            
             return TypeConverter<cv::Mat>::ToNapi(info.Env(), image); });
         }
 
+        Napi::Value ImreadAsync(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            ImreadArgs args = ParseImreadArgs(info);
+            return QueueMatJob(info.Env(), PinArgs(info), ParseJobOptions(info, 1), [args]()
+                               {
+                cv::Mat image = RunImread(args);
+                if (image.empty()) {
+                    throw std::runtime_error("无法读取图像: " + args.filename);
+                }
+                return image; }); });
+        }
+
         // 写入图像
         Napi::Value Imwrite(const Napi::CallbackInfo &info)
         {
             return SafeCall(info.Env(), [&]() -> Napi::Value
                             {
-            if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
-                throw Napi::TypeError::New(info.Env(), "期望字符串和 Mat 对象参数");
-            }
-            
-            std::string filename = info[0].As<Napi::String>().Utf8Value();
-            cv::Mat image = TypeConverter<cv::Mat>::FromNapi(info[1]);
-            
-            bool success = cv::imwrite(filename, image);
+            ImwriteArgs args = ParseImwriteArgs(info);
+            bool success = cv::imwrite(args.filename, args.image);
             return Napi::Boolean::New(info.Env(), success); });
         }
 
+        Napi::Value ImwriteAsync(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            ImwriteArgs args = ParseImwriteArgs(info);
+            auto success = std::make_shared<bool>(false);
+            return QueueJob(
+                info.Env(), PinArgs(info), ParseJobOptions(info, 2),
+                [args, success]()
+                { *success = cv::imwrite(args.filename, args.image); },
+                [success](Napi::Env env) -> Napi::Value
+                { return Napi::Boolean::New(env, *success); }); });
+        }
+
 #define PLACEHOLDER_IMPL(func_name)                                                            \
     Napi::Value func_name(const Napi::CallbackInfo &info)                                      \
     {                                                                                          \
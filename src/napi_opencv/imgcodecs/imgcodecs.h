@@ -10,7 +10,9 @@ namespace ImgCodecs {
 
     // ==================== 基础图像I/O函数 ====================
     Napi::Value Imread(const Napi::CallbackInfo &info);
+    Napi::Value ImreadAsync(const Napi::CallbackInfo &info);
     Napi::Value Imwrite(const Napi::CallbackInfo &info);
+    Napi::Value ImwriteAsync(const Napi::CallbackInfo &info);
     Napi::Value Imdecode(const Napi::CallbackInfo &info);
     Napi::Value Imencode(const Napi::CallbackInfo &info);
     
@@ -1,7 +1,11 @@
 #include "imgproc.h"
+#include "../common/allocator.h"
+#include "../common/async_job.h"
 #include "../common/safe_call.h"
 #include "../common/type_converters.h"
 #include <opencv2/imgproc.hpp>
+#include <memory>
+#include <vector>
 
 using namespace NapiOpenCV::Common;
 
@@ -15,6 +19,7 @@ namespace NapiOpenCV
             // 滤波函数
             exports.Set("blur", Napi::Function::New(env, Blur));
             exports.Set("gaussianBlur", Napi::Function::New(env, GaussianBlur));
+            exports.Set("gaussianBlurAsync", Napi::Function::New(env, GaussianBlurAsync));
             exports.Set("medianBlur", Napi::Function::New(env, MedianBlur));
             exports.Set("bilateralFilter", Napi::Function::New(env, BilateralFilter));
             exports.Set("filter2D", Napi::Function::New(env, Filter2D));
@@ -24,6 +29,8 @@ namespace NapiOpenCV
 
             // 几何变换函数
             exports.Set("resize", Napi::Function::New(env, Resize));
+            exports.Set("resizeAsync", Napi::Function::New(env, ResizeAsync));
+            exports.Set("resizeBatch", Napi::Function::New(env, ResizeBatch));
             exports.Set("warpAffine", Napi::Function::New(env, WarpAffine));
             exports.Set("warpPerspective", Napi::Function::New(env, WarpPerspective));
             exports.Set("getRotationMatrix2D", Napi::Function::New(env, GetRotationMatrix2D));
@@ -61,6 +68,8 @@ namespace NapiOpenCV
 
             // 色彩空间转换
             exports.Set("cvtColor", Napi::Function::New(env, CvtColor));
+            exports.Set("cvtColorAsync", Napi::Function::New(env, CvtColorAsync));
+            exports.Set("cvtColorBatch", Napi::Function::New(env, CvtColorBatch));
 
             // 直方图函数
             exports.Set("calcHist", Napi::Function::New(env, CalcHist));
@@ -133,70 +142,183 @@ namespace NapiOpenCV
         }
 
         // ==================== 已实现的函数 ====================
+        // 参数解析与计算分开，同步与异步版本共用；计算部分不访问 JS 值，可在工作线程中执行
+
+        namespace
+        {
+            struct ResizeArgs
+            {
+                cv::Mat src;
+                cv::Size dsize;
+                int interpolation = cv::INTER_LINEAR; // 默认线性插值
+            };
+
+            ResizeArgs ParseResizeArgs(const Napi::CallbackInfo &info)
+            {
+                if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject())
+                {
+                    throw Napi::TypeError::New(info.Env(), "期望 Mat 对象和 Size 对象参数");
+                }
+
+                ResizeArgs args;
+                args.src = TypeConverter<cv::Mat>::FromNapi(info[0]);
+                args.dsize = TypeConverter<cv::Size>::FromNapi(info[1]);
+                if (info.Length() > 2 && info[2].IsNumber())
+                {
+                    args.interpolation = info[2].As<Napi::Number>().Int32Value();
+                }
+                return args;
+            }
+
+            cv::Mat RunResize(const ResizeArgs &args)
+            {
+                cv::Mat dst = NewOutputMat();
+                cv::resize(args.src, dst, args.dsize, 0, 0, args.interpolation);
+                return dst;
+            }
+
+            struct GaussianBlurArgs
+            {
+                cv::Mat src;
+                cv::Size ksize;
+                double sigmaX = 0;
+                double sigmaY = 0; // 默认与 sigmaX 相同
+            };
+
+            GaussianBlurArgs ParseGaussianBlurArgs(const Napi::CallbackInfo &info)
+            {
+                if (info.Length() < 3 || !info[0].IsObject() || !info[1].IsObject() || !info[2].IsNumber())
+                {
+                    throw Napi::TypeError::New(info.Env(), "期望 Mat 对象、Size 对象和数字参数");
+                }
+
+                GaussianBlurArgs args;
+                args.src = TypeConverter<cv::Mat>::FromNapi(info[0]);
+                args.ksize = TypeConverter<cv::Size>::FromNapi(info[1]);
+                args.sigmaX = info[2].As<Napi::Number>().DoubleValue();
+                if (info.Length() > 3 && info[3].IsNumber())
+                {
+                    args.sigmaY = info[3].As<Napi::Number>().DoubleValue();
+                }
+                return args;
+            }
+
+            cv::Mat RunGaussianBlur(const GaussianBlurArgs &args)
+            {
+                cv::Mat dst = NewOutputMat();
+                cv::GaussianBlur(args.src, dst, args.ksize, args.sigmaX, args.sigmaY);
+                return dst;
+            }
+
+            struct CvtColorArgs
+            {
+                cv::Mat src;
+                int code = 0;
+            };
+
+            CvtColorArgs ParseCvtColorArgs(const Napi::CallbackInfo &info)
+            {
+                if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsNumber())
+                {
+                    throw Napi::TypeError::New(info.Env(), "期望 Mat 对象和数字参数");
+                }
+
+                CvtColorArgs args;
+                args.src = TypeConverter<cv::Mat>::FromNapi(info[0]);
+                args.code = info[1].As<Napi::Number>().Int32Value();
+                return args;
+            }
+
+            cv::Mat RunCvtColor(const CvtColorArgs &args)
+            {
+                cv::Mat dst = NewOutputMat();
+                cv::cvtColor(args.src, dst, args.code);
+                return dst;
+            }
+        } // namespace
 
         // 图像缩放
         Napi::Value Resize(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return TypeConverter<cv::Mat>::ToNapi(info.Env(), RunResize(ParseResizeArgs(info))); });
+        }
+
+        Napi::Value ResizeAsync(const Napi::CallbackInfo &info)
         {
             return SafeCall(info.Env(), [&]() -> Napi::Value
                             {
-            if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
-                throw Napi::TypeError::New(info.Env(), "期望 Mat 对象和 Size 对象参数");
+            ResizeArgs args = ParseResizeArgs(info);
+            return QueueMatJob(info.Env(), PinArgs(info), ParseJobOptions(info, 2), [args]()
+                               { return RunResize(args); }); });
+        }
+
+        // 批量缩放：所有图像使用同一目标尺寸，一次提交
+        Napi::Value ResizeBatch(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsObject()) {
+                throw Napi::TypeError::New(info.Env(), "期望 Mat 数组和 Size 对象参数");
             }
-            
-            cv::Mat src = TypeConverter<cv::Mat>::FromNapi(info[0]);
-            cv::Size dsize = TypeConverter<cv::Size>::FromNapi(info[1]);
-            
-            int interpolation = cv::INTER_LINEAR; // 默认线性插值
+
+            ResizeArgs args;
+            args.dsize = TypeConverter<cv::Size>::FromNapi(info[1]);
             if (info.Length() > 2 && info[2].IsNumber()) {
-                interpolation = info[2].As<Napi::Number>().Int32Value();
+                args.interpolation = info[2].As<Napi::Number>().Int32Value();
             }
-            
-            cv::Mat dst;
-            cv::resize(src, dst, dsize, 0, 0, interpolation);
-            
-            return TypeConverter<cv::Mat>::ToNapi(info.Env(), dst); });
+            auto sources = std::make_shared<std::vector<cv::Mat>>(TypeConverter<std::vector<cv::Mat>>::FromNapi(info[0]));
+            return QueueMatBatchJob(info.Env(), PinArgs(info), ParseJobOptions(info, 2), sources->size(), [args, sources](size_t i)
+                                    {
+                ResizeArgs item = args;
+                item.src = (*sources)[i];
+                return RunResize(item); }); });
         }
 
         // 高斯滤波
         Napi::Value GaussianBlur(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return TypeConverter<cv::Mat>::ToNapi(info.Env(), RunGaussianBlur(ParseGaussianBlurArgs(info))); });
+        }
+
+        Napi::Value GaussianBlurAsync(const Napi::CallbackInfo &info)
         {
             return SafeCall(info.Env(), [&]() -> Napi::Value
                             {
-            if (info.Length() < 3 || !info[0].IsObject() || !info[1].IsObject() || !info[2].IsNumber()) {
-                throw Napi::TypeError::New(info.Env(), "期望 Mat 对象、Size 对象和数字参数");
-            }
-            
-            cv::Mat src = TypeConverter<cv::Mat>::FromNapi(info[0]);
-            cv::Size ksize = TypeConverter<cv::Size>::FromNapi(info[1]);
-            double sigmaX = info[2].As<Napi::Number>().DoubleValue();
-            
-            double sigmaY = 0; // 默认与 sigmaX 相同
-            if (info.Length() > 3 && info[3].IsNumber()) {
-                sigmaY = info[3].As<Napi::Number>().DoubleValue();
-            }
-            
-            cv::Mat dst;
-            cv::GaussianBlur(src, dst, ksize, sigmaX, sigmaY);
-            
-            return TypeConverter<cv::Mat>::ToNapi(info.Env(), dst); });
+            GaussianBlurArgs args = ParseGaussianBlurArgs(info);
+            return QueueMatJob(info.Env(), PinArgs(info), ParseJobOptions(info, 3), [args]()
+                               { return RunGaussianBlur(args); }); });
         }
 
         // 色彩空间转换
         Napi::Value CvtColor(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            { return TypeConverter<cv::Mat>::ToNapi(info.Env(), RunCvtColor(ParseCvtColorArgs(info))); });
+        }
+
+        Napi::Value CvtColorAsync(const Napi::CallbackInfo &info)
         {
             return SafeCall(info.Env(), [&]() -> Napi::Value
                             {
-            if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsNumber()) {
-                throw Napi::TypeError::New(info.Env(), "期望 Mat 对象和数字参数");
+            CvtColorArgs args = ParseCvtColorArgs(info);
+            return QueueMatJob(info.Env(), PinArgs(info), ParseJobOptions(info, 2), [args]()
+                               { return RunCvtColor(args); }); });
+        }
+
+        Napi::Value CvtColorBatch(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsNumber()) {
+                throw Napi::TypeError::New(info.Env(), "期望 Mat 数组和数字参数");
             }
-            
-            cv::Mat src = TypeConverter<cv::Mat>::FromNapi(info[0]);
+
             int code = info[1].As<Napi::Number>().Int32Value();
-            
-            cv::Mat dst;
-            cv::cvtColor(src, dst, code);
-            
-            return TypeConverter<cv::Mat>::ToNapi(info.Env(), dst); });
+            auto sources = std::make_shared<std::vector<cv::Mat>>(TypeConverter<std::vector<cv::Mat>>::FromNapi(info[0]));
+            return QueueMatBatchJob(info.Env(), PinArgs(info), ParseJobOptions(info, 2), sources->size(), [code, sources](size_t i)
+                                    { return RunCvtColor({(*sources)[i], code}); }); });
         }
 
         // ==================== 占位符实现 ====================
@@ -12,6 +12,7 @@ namespace ImgProc {
     // ==================== 滤波函数 ====================
     Napi::Value Blur(const Napi::CallbackInfo &info);
     Napi::Value GaussianBlur(const Napi::CallbackInfo &info);
+    Napi::Value GaussianBlurAsync(const Napi::CallbackInfo &info);
     Napi::Value MedianBlur(const Napi::CallbackInfo &info);
     Napi::Value BilateralFilter(const Napi::CallbackInfo &info);
     Napi::Value Filter2D(const Napi::CallbackInfo &info);
@@ -23,6 +24,8 @@ namespace ImgProc {
 
     // ==================== 几何变换函数 ====================
     Napi::Value Resize(const Napi::CallbackInfo &info);
+    Napi::Value ResizeAsync(const Napi::CallbackInfo &info);
+    Napi::Value ResizeBatch(const Napi::CallbackInfo &info);
     Napi::Value WarpAffine(const Napi::CallbackInfo &info);
     Napi::Value WarpPerspective(const Napi::CallbackInfo &info);
     Napi::Value GetRotationMatrix2D(const Napi::CallbackInfo &info);
@@ -71,6 +74,8 @@ namespace ImgProc {
 
     // ==================== 色彩空间转换 ====================
     Napi::Value CvtColor(const Napi::CallbackInfo &info);
+    Napi::Value CvtColorAsync(const Napi::CallbackInfo &info);
+    Napi::Value CvtColorBatch(const Napi::CallbackInfo &info);
 
     // ==================== 直方图函数 ====================
     Napi::Value CalcHist(const Napi::CallbackInfo &info);
@@ -1,5 +1,8 @@
 #include "napi_opencv.h"
+#include "common/addon_data.h"
 #include "common/type_converters.h"
+#include "common/mat_wrap.h"
+#include "common/parallel_backend.h"
 #include <opencv2/core.hpp>
 
 using namespace NapiOpenCV::Common;
@@ -9,6 +12,12 @@ namespace NapiOpenCV
 
     Napi::Object Init(Napi::Env env, Napi::Object exports)
     {
+        // 每个 env 独立的插件状态，支持在多个 worker_threads 中加载
+        CreateAddonData(env);
+
+        // 按线程预算执行的 parallel_for_ 后端，避免并发任务超额占用核心
+        BudgetParallelBackend::Install();
+
         // 添加版本信息
         Napi::Object version = Napi::Object::New(env);
         version.Set("major", Napi::Number::New(env, CV_VERSION_MAJOR));
@@ -16,7 +25,8 @@ namespace NapiOpenCV
         version.Set("revision", Napi::Number::New(env, CV_VERSION_REVISION));
         exports.Set("version", version);
 
-        // Mat 类暂时移除
+        // 注册 Mat 句柄类
+        MatWrap::Init(env, exports);
 
         // 添加模块信息
         Napi::Object modules = Napi::Object::New(env);
@@ -46,6 +56,9 @@ namespace NapiOpenCV
         Videoio::RegisterFunctions(env, exports);
         Gapi::RegisterFunctions(env, exports);
 
+        // 跨模块的融合流水线
+        Pipeline::RegisterFunctions(env, exports);
+
         return exports;
     }
 
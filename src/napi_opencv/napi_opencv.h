@@ -16,6 +16,7 @@
 #include "flann/flann.h"
 #include "videoio/videoio.h"
 #include "gapi/gapi.h"
+#include "pipeline/pipeline.h"
 
 namespace NapiOpenCV
 {
@@ -0,0 +1,299 @@
+#include "pipeline.h"
+#include "../common/allocator.h"
+#include "../common/async_job.h"
+#include "../common/mat_wrap.h"
+#include "../common/safe_call.h"
+#include "../common/type_converters.h"
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace NapiOpenCV::Common;
+
+namespace NapiOpenCV
+{
+    namespace Pipeline
+    {
+
+        void RegisterFunctions(Napi::Env env, Napi::Object exports)
+        {
+            exports.Set("pipeline", Napi::Function::New(env, RunPipeline));
+        }
+
+        namespace
+        {
+            enum class StageOp
+            {
+                Decode,
+                CvtColor,
+                Resize,
+                GaussianBlur,
+                Encode
+            };
+
+            // 解析后的单个阶段，只包含普通数据，可在工作线程中使用
+            struct Stage
+            {
+                StageOp op = StageOp::CvtColor;
+                int flags = cv::IMREAD_COLOR;         // decode
+                int code = 0;                         // cvtColor
+                cv::Size size;                        // resize
+                double fx = 0;                        // resize
+                double fy = 0;                        // resize
+                int interpolation = cv::INTER_LINEAR; // resize
+                cv::Size ksize;                       // gaussianBlur
+                double sigmaX = 0;                    // gaussianBlur
+                double sigmaY = 0;                    // gaussianBlur
+                std::string ext;                      // encode
+                std::vector<int> params;              // encode
+            };
+
+            struct Plan
+            {
+                std::vector<Stage> stages;
+                bool decodes = false;
+                bool encodes = false;
+            };
+
+            Napi::TypeError StageError(Napi::Env env, size_t index, const std::string &message)
+            {
+                return Napi::TypeError::New(env, "第 " + std::to_string(index) + " 个阶段: " + message);
+            }
+
+            double NumberField(Napi::Object object, const char *key, double fallback)
+            {
+                Napi::Value value = object.Get(key);
+                return value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : fallback;
+            }
+
+            // 在 JS 线程一次性校验整条链：未知操作、参数缺失或阶段顺序错误都在提交前报错
+            Plan ParsePlan(Napi::Env env, Napi::Array array)
+            {
+                Plan plan;
+                uint32_t count = array.Length();
+                if (count == 0)
+                {
+                    throw Napi::TypeError::New(env, "流水线至少需要一个阶段");
+                }
+
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    Napi::Value item = array.Get(i);
+                    if (!item.IsObject() || !item.As<Napi::Object>().Get("op").IsString())
+                    {
+                        throw StageError(env, i, "期望 {op, ...} 对象");
+                    }
+
+                    Napi::Object object = item.As<Napi::Object>();
+                    std::string op = object.Get("op").As<Napi::String>().Utf8Value();
+                    Stage stage;
+
+                    if (op == "decode")
+                    {
+                        if (i != 0)
+                        {
+                            throw StageError(env, i, "decode 只能是第一个阶段");
+                        }
+                        stage.op = StageOp::Decode;
+                        stage.flags = static_cast<int>(NumberField(object, "flags", cv::IMREAD_COLOR));
+                        plan.decodes = true;
+                    }
+                    else if (op == "cvtColor")
+                    {
+                        if (!object.Get("code").IsNumber())
+                        {
+                            throw StageError(env, i, "cvtColor 需要数字参数 code");
+                        }
+                        stage.op = StageOp::CvtColor;
+                        stage.code = object.Get("code").As<Napi::Number>().Int32Value();
+                    }
+                    else if (op == "resize")
+                    {
+                        stage.op = StageOp::Resize;
+                        if (object.Get("size").IsObject())
+                        {
+                            stage.size = TypeConverter<cv::Size>::FromNapi(object.Get("size"));
+                        }
+                        else
+                        {
+                            stage.size.width = static_cast<int>(NumberField(object, "width", 0));
+                            stage.size.height = static_cast<int>(NumberField(object, "height", 0));
+                        }
+                        stage.fx = NumberField(object, "fx", 0);
+                        stage.fy = NumberField(object, "fy", 0);
+                        stage.interpolation = static_cast<int>(NumberField(object, "interpolation", cv::INTER_LINEAR));
+                        if (stage.size.area() <= 0 && (stage.fx <= 0 || stage.fy <= 0))
+                        {
+                            throw StageError(env, i, "resize 需要 {width, height}、size 或正数 fx/fy");
+                        }
+                    }
+                    else if (op == "gaussianBlur")
+                    {
+                        stage.op = StageOp::GaussianBlur;
+                        Napi::Value ksize = object.Get("ksize");
+                        if (ksize.IsNumber())
+                        {
+                            int k = ksize.As<Napi::Number>().Int32Value();
+                            stage.ksize = cv::Size(k, k);
+                        }
+                        else if (ksize.IsObject())
+                        {
+                            stage.ksize = TypeConverter<cv::Size>::FromNapi(ksize);
+                        }
+                        stage.sigmaX = NumberField(object, "sigmaX", 0);
+                        stage.sigmaY = NumberField(object, "sigmaY", 0);
+                        if (stage.ksize.area() <= 0 && stage.sigmaX <= 0)
+                        {
+                            throw StageError(env, i, "gaussianBlur 需要 ksize 或正数 sigmaX");
+                        }
+                    }
+                    else if (op == "encode")
+                    {
+                        if (i != count - 1)
+                        {
+                            throw StageError(env, i, "encode 只能是最后一个阶段");
+                        }
+                        if (!object.Get("ext").IsString())
+                        {
+                            throw StageError(env, i, "encode 需要字符串参数 ext，例如 '.jpg'");
+                        }
+                        stage.op = StageOp::Encode;
+                        stage.ext = object.Get("ext").As<Napi::String>().Utf8Value();
+                        if (object.Get("params").IsArray())
+                        {
+                            Napi::Array params = object.Get("params").As<Napi::Array>();
+                            for (uint32_t j = 0; j < params.Length(); j++)
+                            {
+                                stage.params.push_back(params.Get(j).ToNumber().Int32Value());
+                            }
+                        }
+                        plan.encodes = true;
+                    }
+                    else
+                    {
+                        throw StageError(env, i, "未知操作 '" + op + "'");
+                    }
+
+                    plan.stages.push_back(stage);
+                }
+                return plan;
+            }
+
+            void RunStage(const Stage &stage, const cv::Mat &src, cv::Mat &dst)
+            {
+                switch (stage.op)
+                {
+                case StageOp::CvtColor:
+                    cv::cvtColor(src, dst, stage.code);
+                    break;
+                case StageOp::Resize:
+                    cv::resize(src, dst, stage.size, stage.fx, stage.fy, stage.interpolation);
+                    break;
+                case StageOp::GaussianBlur:
+                    cv::GaussianBlur(src, dst, stage.ksize, stage.sigmaX, stage.sigmaY);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            struct PipelineResult
+            {
+                cv::Mat mat;
+                std::vector<uchar> encoded;
+            };
+
+            // 中间结果在两块缓冲之间交替写入，尺寸不变的阶段直接复用已分配的内存
+            void ExecutePlan(const Plan &plan, const cv::Mat &input, PipelineResult &result)
+            {
+                cv::Mat current = input;
+                size_t first = 0;
+                if (plan.decodes)
+                {
+                    cv::Mat decoded = NewOutputMat();
+                    cv::imdecode(input, plan.stages[0].flags, &decoded);
+                    if (decoded.empty())
+                    {
+                        throw std::runtime_error("无法解码输入图像");
+                    }
+                    current = decoded;
+                    first = 1;
+                }
+
+                size_t last = plan.encodes ? plan.stages.size() - 1 : plan.stages.size();
+                cv::Mat buffers[2] = {NewOutputMat(), NewOutputMat()};
+                int next = 0;
+                for (size_t i = first; i < last; i++)
+                {
+                    ThrowIfCancelled();
+                    RunStage(plan.stages[i], current, buffers[next]);
+                    current = buffers[next];
+                    next ^= 1;
+                }
+
+                if (plan.encodes)
+                {
+                    ThrowIfCancelled();
+                    const Stage &encode = plan.stages.back();
+                    if (!cv::imencode(encode.ext, current, result.encoded, encode.params))
+                    {
+                        throw std::runtime_error("无法编码为 " + encode.ext);
+                    }
+                    return;
+                }
+
+                // 输入 Mat 原样通过（没有处理阶段）时复制一份，结果不与输入共享内存
+                result.mat = current.data == input.data ? CloneMat(current) : current;
+            }
+        } // namespace
+
+        Napi::Value RunPipeline(const Napi::CallbackInfo &info)
+        {
+            return SafeCall(info.Env(), [&]() -> Napi::Value
+                            {
+            Napi::Env env = info.Env();
+            if (info.Length() < 2 || !info[0].IsArray()) {
+                throw Napi::TypeError::New(env, "期望阶段数组和输入参数");
+            }
+
+            auto plan = std::make_shared<Plan>(ParsePlan(env, info[0].As<Napi::Array>()));
+
+            // decode 开头时输入为编码后的字节，否则为 Mat；字节在任务结束前由 pins 固定
+            cv::Mat input;
+            if (plan->decodes) {
+                uint8_t *data = nullptr;
+                size_t length = 0;
+                if (!MatWrap::GetBytes(env, info[1], data, length)) {
+                    throw Napi::TypeError::New(env, "decode 阶段期望 Buffer、TypedArray 或 ArrayBuffer 输入");
+                }
+                input = cv::Mat(1, static_cast<int>(length), CV_8U, data);
+            } else {
+                input = TypeConverter<cv::Mat>::FromNapi(info[1]);
+            }
+
+            auto result = std::make_shared<PipelineResult>();
+            return QueueJob(
+                env, PinArgs(info), ParseJobOptions(info, 2),
+                [plan, input, result]()
+                { ExecutePlan(*plan, input, *result); },
+                [plan, result](Napi::Env env) -> Napi::Value
+                {
+                    if (!plan->encodes) {
+                        return TypeConverter<cv::Mat>::ToNapi(env, result->mat);
+                    }
+
+                    // 编码结果直接作为外部 Buffer 交给 JS，不再复制
+                    auto *encoded = new std::vector<uchar>(std::move(result->encoded));
+                    return Napi::Buffer<uint8_t>::NewOrCopy(
+                        env, encoded->data(), encoded->size(),
+                        [](Napi::Env, uint8_t *, std::vector<uchar> *hint)
+                        { delete hint; },
+                        encoded);
+                }); });
+        }
+
+    } // namespace Pipeline
+} // namespace NapiOpenCV
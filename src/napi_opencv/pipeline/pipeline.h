@@ -0,0 +1,18 @@
+#ifndef NAPI_OPENCV_PIPELINE_H
+#define NAPI_OPENCV_PIPELINE_H
+
+#include <napi.h>
+
+namespace NapiOpenCV {
+namespace Pipeline {
+
+    void RegisterFunctions(Napi::Env env, Napi::Object exports);
+
+    // ==================== 融合流水线 ====================
+    // pipeline(stages, input[, options])：整条操作链在一个后台任务中执行，只返回最终结果
+    Napi::Value RunPipeline(const Napi::CallbackInfo &info);
+
+} // namespace Pipeline
+} // namespace NapiOpenCV
+
+#endif // NAPI_OPENCV_PIPELINE_H
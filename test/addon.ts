@@ -0,0 +1,30 @@
+import { createRequire } from "module";
+
+const require = createRequire(import.meta.url);
+
+// 已构建插件的绝对路径，供 worker_threads 中的测试代码加载；未构建时为 undefined
+export function addonPath(): string | undefined {
+  for (const path of ["../build/Release/opencv_napi.node", "../build/Debug/opencv_napi.node"]) {
+    try {
+      return require.resolve(path);
+    } catch {
+      // 尝试下一个构建目录
+    }
+  }
+  return undefined;
+}
+
+// 已构建的插件，未构建时为 undefined，依赖插件的测试据此跳过
+export function loadAddon(): any {
+  const path = addonPath();
+  return path ? require(path) : undefined;
+}
+
+// 需要以 --expose-gc 运行才能强制回收，否则只验证不依赖 GC 的部分
+export async function collectGarbage(): Promise<void> {
+  const gc = (globalThis as any).gc as (() => void) | undefined;
+  for (let i = 0; i < 3; i++) {
+    gc?.();
+    await new Promise((resolve) => setImmediate(resolve));
+  }
+}
@@ -0,0 +1,78 @@
+import { describe, it, expect, beforeAll, afterEach } from "vitest";
+import { loadAddon } from "./addon";
+
+const opencv = loadAddon();
+const CV_8UC1 = 0;
+
+describe.skipIf(!opencv)("批量调用", () => {
+  let defaults: any;
+
+  beforeAll(() => {
+    defaults = opencv.schedulerStats();
+  });
+
+  afterEach(() => {
+    opencv.schedulerConfigure({ workers: defaults.workers, maxQueue: defaults.maxQueue, policy: defaults.policy });
+  });
+
+  function images(values: number[]) {
+    return values.map((value) => new opencv.Mat(8, 8, CV_8UC1, [value]));
+  }
+
+  it("resizeBatch 的结果数量与顺序与输入一致", async () => {
+    const values = Array.from({ length: 16 }, (_, i) => i * 10);
+    const results = await opencv.resizeBatch(images(values), { width: 4, height: 4 });
+
+    expect(results).toHaveLength(values.length);
+    results.forEach((result: any, i: number) => {
+      expect(result.rows).toBe(4);
+      expect(result.cols).toBe(4);
+      expect(result.data[0]).toBe(values[i]);
+    });
+  });
+
+  it("cvtColorBatch 返回与输入一一对应的结果", async () => {
+    const COLOR_GRAY2BGR = 8;
+    const results = await opencv.cvtColorBatch(images([1, 2, 3]), COLOR_GRAY2BGR);
+    expect(results.map((result: any) => result.channels)).toEqual([3, 3, 3]);
+    expect(results.map((result: any) => result.data[0])).toEqual([1, 2, 3]);
+  });
+
+  it("空数组得到空结果", async () => {
+    await expect(opencv.resizeBatch([], { width: 4, height: 4 })).resolves.toEqual([]);
+  });
+
+  it("任一输入失败时整体拒绝并给出其序号", async () => {
+    const inputs = images([1, 2, 3, 4]);
+    inputs.splice(2, 0, new opencv.Mat());
+    await expect(opencv.resizeBatch(inputs, { width: 4, height: 4 })).rejects.toThrow("第 2 个输入");
+  });
+
+  it("有输入无法入队时整体以 '任务队列已满' 拒绝", async () => {
+    opencv.schedulerConfigure({ workers: 1, maxQueue: 2, policy: "reject" });
+    const large = Array.from({ length: 16 }, () => new opencv.Mat(1000, 1000, CV_8UC1, [7]));
+    await expect(opencv.resizeBatch(large, { width: 2000, height: 2000 })).rejects.toThrow("任务队列已满");
+
+    // 已入队的输入被移出或运行结束，队列恢复空闲
+    await expect(opencv.resizeBatch(images([5]), { width: 4, height: 4 })).resolves.toHaveLength(1);
+  });
+
+  it("已取消的 signal 以 signal.reason 拒绝", async () => {
+    const reason = new Error("批量取消");
+    await expect(
+      opencv.resizeBatch(images([1, 2]), { width: 4, height: 4 }, { signal: AbortSignal.abort(reason) })
+    ).rejects.toBe(reason);
+  });
+
+  it("abort 移出仍在队列中的输入", async () => {
+    opencv.schedulerConfigure({ workers: 1, maxQueue: 64, policy: "reject" });
+    const large = Array.from({ length: 16 }, () => new opencv.Mat(1000, 1000, CV_8UC1, [7]));
+    const controller = new AbortController();
+    const pending = opencv.resizeBatch(large, { width: 2000, height: 2000 }, { signal: controller.signal });
+
+    const reason = new Error("批量取消");
+    controller.abort(reason);
+    expect(opencv.schedulerStats().queueDepth).toBe(0);
+    await expect(pending).rejects.toBe(reason);
+  });
+});
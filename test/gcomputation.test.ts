@@ -0,0 +1,86 @@
+import { describe, it, expect, afterEach } from "vitest";
+import { loadAddon } from "./addon";
+
+const opencv = loadAddon();
+const CV_8UC1 = 0;
+
+describe.skipIf(!opencv)("GComputation 句柄", () => {
+  function blurGraph() {
+    return new opencv.GComputation([opencv.gapiblur(3)]);
+  }
+
+  it("release() 之后拒绝继续使用，重复调用无副作用", () => {
+    const g = blurGraph();
+    const input = new opencv.Mat(8, 8, CV_8UC1, [10]);
+    expect(g.apply(input).rows).toBe(8);
+
+    g.release();
+    g.release();
+    expect(g.isReleased).toBe(true);
+    expect(() => g.apply(input)).toThrow("GComputation 已释放");
+    expect(() => g.compile(input)).toThrow("GComputation 已释放");
+    expect(() => g.applyAsync(input)).toThrow("GComputation 已释放");
+    expect(() => opencv.gstreamingcompile(g)).toThrow("GComputation 已释放");
+  });
+
+  it("已提交的 applyAsync 不受 release() 影响", async () => {
+    const g = blurGraph();
+    const pending = g.applyAsync(new opencv.Mat(8, 8, CV_8UC1, [10]));
+    g.release();
+    expect((await pending).cols).toBe(8);
+  });
+
+  it("Symbol.dispose 指向 release()", () => {
+    const dispose = (Symbol as any).dispose ?? Symbol.for("Symbol.dispose");
+    const g = blurGraph();
+    expect(g[dispose]).toBe(g.release);
+    g[dispose]();
+    expect(g.isReleased).toBe(true);
+  });
+});
+
+describe.skipIf(!opencv)("编译结果缓存", () => {
+  afterEach(() => {
+    opencv.gapiCacheConfigure({ capacity: 64 });
+  });
+
+  function delta(before: any) {
+    const after = opencv.gapiCacheStats();
+    return { hits: after.hits - before.hits, misses: after.misses - before.misses, entries: after.entries };
+  }
+
+  it("操作相同的两个 GComputation 对同一尺寸和类型只编译一次", () => {
+    opencv.gapiCacheClear();
+    const before = opencv.gapiCacheStats();
+    const input = new opencv.Mat(8, 8, CV_8UC1, [10]);
+
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(input);
+    expect(delta(before)).toEqual({ hits: 0, misses: 1, entries: 1 });
+
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(new opencv.Mat(8, 8, CV_8UC1, [20]));
+    expect(delta(before)).toEqual({ hits: 1, misses: 1, entries: 1 });
+  });
+
+  it("输入尺寸或操作不同时分别编译", () => {
+    opencv.gapiCacheClear();
+    const before = opencv.gapiCacheStats();
+
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(new opencv.Mat(8, 8, CV_8UC1, [10]));
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(new opencv.Mat(16, 8, CV_8UC1, [10]));
+    new opencv.GComputation([opencv.gapiblur(5)]).apply(new opencv.Mat(8, 8, CV_8UC1, [10]));
+    expect(delta(before)).toEqual({ hits: 0, misses: 3, entries: 3 });
+  });
+
+  it("capacity 为 0 时不缓存，gapiCacheClear 清空条目", () => {
+    const input = new opencv.Mat(8, 8, CV_8UC1, [10]);
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(input);
+    opencv.gapiCacheClear();
+    expect(opencv.gapiCacheStats().entries).toBe(0);
+
+    opencv.gapiCacheConfigure({ capacity: 0 });
+    const before = opencv.gapiCacheStats();
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(input);
+    new opencv.GComputation([opencv.gapiblur(3)]).apply(input);
+    expect(delta(before)).toEqual({ hits: 0, misses: 2, entries: 0 });
+  });
+});
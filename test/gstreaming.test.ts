@@ -0,0 +1,59 @@
+import { describe, it, expect } from "vitest";
+import { loadAddon } from "./addon";
+
+const opencv = loadAddon();
+
+describe.skipIf(!opencv)("GStreaming 句柄", () => {
+  function compileStream() {
+    return opencv.gstreamingcompile(new opencv.GComputation([opencv.gapiblur(3)]));
+  }
+
+  it("release() 不阻塞，返回的 Promise 在拉取线程退出后 resolve", async () => {
+    const streaming = compileStream();
+    streaming.start("does-not-exist.avi");
+
+    const released = streaming.release();
+    expect(released).toBeInstanceOf(Promise);
+    expect(streaming.isReleased).toBe(true);
+    await expect(released).resolves.toBeUndefined();
+    await expect(streaming.release()).resolves.toBeUndefined();
+    await expect(streaming.next()).resolves.toEqual({ value: undefined, done: true });
+    expect(() => streaming.start("does-not-exist.avi")).toThrow("GStreaming 已释放");
+  });
+
+  it("release() 之前提交的 next() 仍会完成", async () => {
+    const streaming = compileStream();
+    streaming.start("does-not-exist.avi");
+    const pending = streaming.next();
+
+    const released = streaming.release();
+    // 打开视频源失败时被拒绝，否则以 done 结束；两者都说明请求没有被丢下
+    await pending.then(
+      (result: { done: boolean }) => expect(result.done).toBe(true),
+      (error: Error) => expect(error).toBeInstanceOf(Error)
+    );
+    await released;
+  });
+
+  it("未启动时 release() 立即 resolve", async () => {
+    const streaming = compileStream();
+    await expect(streaming.release()).resolves.toBeUndefined();
+    expect(streaming.isReleased).toBe(true);
+  });
+
+  it("Symbol.dispose 指向 release()", () => {
+    const dispose = (Symbol as any).dispose ?? Symbol.for("Symbol.dispose");
+    const streaming = compileStream();
+    expect(streaming[dispose]).toBe(streaming.release);
+    streaming[dispose]();
+    expect(streaming.isReleased).toBe(true);
+  });
+
+  it("Symbol.asyncDispose 指向 release()", async () => {
+    const asyncDispose = (Symbol as any).asyncDispose ?? Symbol.for("Symbol.asyncDispose");
+    const streaming = compileStream();
+    expect(streaming[asyncDispose]).toBe(streaming.release);
+    await streaming[asyncDispose]();
+    expect(streaming.isReleased).toBe(true);
+  });
+});
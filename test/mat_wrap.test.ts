@@ -0,0 +1,45 @@
+import { describe, it, expect } from "vitest";
+import { collectGarbage, loadAddon } from "./addon";
+
+const opencv = loadAddon();
+const CV_8UC1 = 0;
+const CV_32FC1 = 5;
+
+describe.skipIf(!opencv)("Mat 句柄", () => {
+  describe("借用内存的导出", () => {
+    // 源 Buffer 只被 Mat 引用，导出后释放句柄并回收，导出的视图必须仍指向有效内存
+    function exportFromBorrowed(kind: "getData" | "data" | "toObject") {
+      const source = Buffer.alloc(4 * 4);
+      for (let i = 0; i < source.length; i++) {
+        source[i] = i + 1;
+      }
+      const mat = opencv.Mat.fromBuffer(source, 4, 4, CV_8UC1);
+      const exported =
+        kind === "getData" ? mat.getData() : kind === "data" ? mat.data : mat.toObject().data;
+      mat.release();
+      return exported as Uint8Array;
+    }
+
+    for (const kind of ["getData", "data", "toObject"] as const) {
+      it(`${kind} 导出的内存在 release() 之后仍然有效`, async () => {
+        const exported = exportFromBorrowed(kind);
+        await collectGarbage();
+
+        // 分配同尺寸的内存，如果源 Buffer 已被回收，这些分配可能复用同一块内存
+        const churn = Array.from({ length: 64 }, () => Buffer.alloc(16, 0xee));
+        expect(Array.from(exported)).toEqual(Array.from({ length: 16 }, (_, i) => i + 1));
+        expect(churn.length).toBe(64);
+      });
+    }
+
+    it("TypedArray 视图保留元素类型", async () => {
+      const values = new Float32Array([1.5, 2.5, 3.5, 4.5]);
+      const mat = opencv.Mat.fromBuffer(values, 2, 2, CV_32FC1);
+      const view = mat.data;
+      mat.release();
+      await collectGarbage();
+      expect(view).toBeInstanceOf(Float32Array);
+      expect(Array.from(view)).toEqual([1.5, 2.5, 3.5, 4.5]);
+    });
+  });
+});
@@ -0,0 +1,87 @@
+import { describe, it, expect } from "vitest";
+import { loadAddon } from "./addon";
+
+const opencv = loadAddon();
+const CV_8UC3 = 16;
+const COLOR_BGR2GRAY = 6;
+const PNG_SIGNATURE = [0x89, 0x50, 0x4e, 0x47];
+
+describe.skipIf(!opencv)("融合流水线", () => {
+  function image() {
+    return new opencv.Mat(16, 16, CV_8UC3, [30, 60, 90]);
+  }
+
+  describe("提交前校验", () => {
+    const cases: [string, object[], string][] = [
+      ["空阶段数组", [], "流水线至少需要一个阶段"],
+      ["缺少 op", [{ width: 4 }], "第 0 个阶段: 期望 {op, ...} 对象"],
+      ["未知操作", [{ op: "sharpen" }], "第 0 个阶段: 未知操作 'sharpen'"],
+      ["decode 不在开头", [{ op: "cvtColor", code: COLOR_BGR2GRAY }, { op: "decode" }], "第 1 个阶段: decode 只能是第一个阶段"],
+      ["encode 不在末尾", [{ op: "encode", ext: ".png" }, { op: "cvtColor", code: COLOR_BGR2GRAY }], "第 0 个阶段: encode 只能是最后一个阶段"],
+      ["encode 缺少 ext", [{ op: "encode" }], "第 0 个阶段: encode 需要字符串参数 ext"],
+      ["cvtColor 缺少 code", [{ op: "cvtColor" }], "第 0 个阶段: cvtColor 需要数字参数 code"],
+      ["resize 缺少尺寸", [{ op: "resize" }], "第 0 个阶段: resize 需要 {width, height}、size 或正数 fx/fy"],
+      ["gaussianBlur 缺少参数", [{ op: "gaussianBlur" }], "第 0 个阶段: gaussianBlur 需要 ksize 或正数 sigmaX"],
+    ];
+
+    for (const [name, stages, message] of cases) {
+      it(name, () => {
+        expect(() => opencv.pipeline(stages, image())).toThrow(message);
+      });
+    }
+
+    it("decode 开头时输入必须是字节", () => {
+      expect(() => opencv.pipeline([{ op: "decode" }], image())).toThrow(
+        "decode 阶段期望 Buffer、TypedArray 或 ArrayBuffer 输入"
+      );
+    });
+  });
+
+  it("不含 encode 时结果为 Mat", async () => {
+    const result = await opencv.pipeline(
+      [
+        { op: "cvtColor", code: COLOR_BGR2GRAY },
+        { op: "resize", width: 8, height: 4 },
+        { op: "gaussianBlur", ksize: 3 },
+      ],
+      image()
+    );
+    expect(result.rows).toBe(4);
+    expect(result.cols).toBe(8);
+    expect(result.channels).toBe(1);
+  });
+
+  it("以 encode 结尾时结果为 Buffer", async () => {
+    const encoded = await opencv.pipeline(
+      [
+        { op: "resize", width: 8, height: 8 },
+        { op: "encode", ext: ".png" },
+      ],
+      image()
+    );
+    expect(Buffer.isBuffer(encoded)).toBe(true);
+    expect(Array.from(encoded.subarray(0, 4))).toEqual(PNG_SIGNATURE);
+  });
+
+  it("decode 到 encode 的整条链", async () => {
+    const png = await opencv.pipeline([{ op: "encode", ext: ".png" }], image());
+    const thumbnail = await opencv.pipeline(
+      [
+        { op: "decode" },
+        { op: "resize", width: 4, height: 4 },
+        { op: "encode", ext: ".png" },
+      ],
+      png
+    );
+    expect(Buffer.isBuffer(thumbnail)).toBe(true);
+
+    const decoded = await opencv.pipeline([{ op: "decode" }, { op: "resize", fx: 0.5, fy: 0.5 }], thumbnail);
+    expect(decoded.rows).toBe(2);
+    expect(decoded.cols).toBe(2);
+    expect(decoded.channels).toBe(3);
+  });
+
+  it("无法解码的输入被拒绝", async () => {
+    await expect(opencv.pipeline([{ op: "decode" }], Buffer.from("not an image"))).rejects.toThrow("无法解码输入图像");
+  });
+});
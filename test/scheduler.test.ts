@@ -0,0 +1,198 @@
+import { describe, it, expect, beforeAll, afterEach } from "vitest";
+import { loadAddon } from "./addon";
+
+const opencv = loadAddon();
+const CV_8UC1 = 0;
+const CV_8UC3 = 16;
+
+describe.skipIf(!opencv)("任务调度器", () => {
+  let defaults: any;
+  let big: any;
+
+  beforeAll(() => {
+    defaults = opencv.schedulerStats();
+    // 单线程上的大核高斯滤波耗时数十毫秒，足以在它运行期间排满队列
+    big = new opencv.Mat(1500, 1500, CV_8UC3, [100, 150, 200]);
+  });
+
+  afterEach(() => {
+    opencv.schedulerConfigure({
+      workers: defaults.workers,
+      maxQueue: defaults.maxQueue,
+      policy: defaults.policy,
+      waitTimeoutMs: 1000,
+      threadsPerJob: defaults.threadsPerJob,
+      reservedWorkers: defaults.reservedWorkers,
+      interactiveWeight: defaults.interactiveWeight,
+    });
+  });
+
+  function slowJob(options: object = {}) {
+    return opencv.gaussianBlurAsync(big, { width: 31, height: 31 }, 10, options);
+  }
+
+  function settle(promise: Promise<unknown>) {
+    return promise.then(
+      () => "resolved",
+      (error: Error) => error.message
+    );
+  }
+
+  describe("有界队列", () => {
+    it("队列已满时以 '任务队列已满' 拒绝并计入 rejected", async () => {
+      opencv.schedulerConfigure({ workers: 1, maxQueue: 1, policy: "reject" });
+      const before = opencv.schedulerStats();
+
+      const results = await Promise.all(Array.from({ length: 8 }, () => settle(slowJob())));
+      const rejected = results.filter((result) => result === "任务队列已满").length;
+      const resolved = results.filter((result) => result === "resolved").length;
+
+      // 一个在运行、一个在排队，其余立即被拒绝
+      expect(rejected).toBeGreaterThan(0);
+      expect(resolved + rejected).toBe(8);
+
+      const after = opencv.schedulerStats();
+      expect(after.rejected - before.rejected).toBe(rejected);
+      expect(after.submitted - before.submitted).toBe(resolved);
+      expect(after.completed - before.completed).toBe(resolved);
+      expect(after.queueDepth).toBe(0);
+      expect(after.running).toBe(0);
+    });
+
+    it("'wait' 策略立即返回 Promise，空出位置后任务依次完成", async () => {
+      opencv.schedulerConfigure({ workers: 1, maxQueue: 1, policy: "wait", waitTimeoutMs: 10000 });
+
+      const pending = Array.from({ length: 4 }, () => slowJob());
+      // 提交不阻塞事件循环，超出队列的任务在本 env 中等待
+      expect(opencv.schedulerStats().waiting).toBeGreaterThan(0);
+
+      const results = await Promise.all(pending.map(settle));
+      expect(results).toEqual(["resolved", "resolved", "resolved", "resolved"]);
+      expect(opencv.schedulerStats().waiting).toBe(0);
+    });
+
+    it("'wait' 策略在超过 waitTimeoutMs 后拒绝", async () => {
+      opencv.schedulerConfigure({ workers: 1, maxQueue: 1, policy: "wait", waitTimeoutMs: 1 });
+      const before = opencv.schedulerStats();
+
+      const results = await Promise.all(Array.from({ length: 8 }, () => settle(slowJob())));
+      const rejected = results.filter((result) => result === "任务队列已满").length;
+      expect(rejected).toBeGreaterThan(0);
+      expect(opencv.schedulerStats().rejected - before.rejected).toBe(rejected);
+    });
+  });
+
+  describe("取消", () => {
+    it("abort 把仍在队列中的任务移出，以 signal.reason 拒绝", async () => {
+      opencv.schedulerConfigure({ workers: 1, maxQueue: 16, policy: "reject" });
+      const running = slowJob();
+      const controller = new AbortController();
+      const queued = slowJob({ signal: controller.signal });
+      const before = opencv.schedulerStats();
+
+      const reason = new Error("用户取消");
+      controller.abort(reason);
+      // 移出在 abort 事件中同步完成，不等正在运行的任务
+      expect(opencv.schedulerStats().queueDepth).toBe(before.queueDepth - 1);
+      await expect(queued).rejects.toBe(reason);
+      expect(opencv.schedulerStats().cancelled - before.cancelled).toBe(1);
+      await running;
+    });
+
+    it("未提供 reason 时以 AbortError 拒绝", async () => {
+      opencv.schedulerConfigure({ workers: 1, maxQueue: 16, policy: "reject" });
+      const running = slowJob();
+      const controller = new AbortController();
+      const queued = slowJob({ signal: controller.signal });
+
+      controller.abort();
+      await expect(queued).rejects.toMatchObject({ name: "AbortError" });
+      await running;
+    });
+
+    it("已经取消的 signal 不再入队", async () => {
+      const before = opencv.schedulerStats();
+      const reason = new Error("提前取消");
+      await expect(slowJob({ signal: AbortSignal.abort(reason) })).rejects.toBe(reason);
+      expect(opencv.schedulerStats().submitted).toBe(before.submitted);
+    });
+
+    it("任务完成后 abort 不影响结果", async () => {
+      const controller = new AbortController();
+      const small = new opencv.Mat(8, 8, CV_8UC1, [10]);
+      const result = await opencv.resizeAsync(small, { width: 4, height: 4 }, { signal: controller.signal });
+      controller.abort();
+      expect(result.cols).toBe(4);
+    });
+  });
+
+  describe("优先级通道", () => {
+    it("交互式任务越过积压的批量任务", async () => {
+      opencv.schedulerConfigure({ workers: 1, maxQueue: 16, policy: "reject", reservedWorkers: 0 });
+      const before = opencv.schedulerStats();
+      const order: string[] = [];
+      const track = (label: string, promise: Promise<unknown>) => promise.then(() => order.push(label));
+
+      const small = new opencv.Mat(8, 8, CV_8UC1, [10]);
+      const pending = [
+        ...Array.from({ length: 4 }, (_, i) => track(`bulk${i}`, slowJob({ priority: "bulk" }))),
+        track("interactive", opencv.resizeAsync(small, { width: 4, height: 4 }, { priority: "interactive" })),
+      ];
+      await Promise.all(pending);
+
+      // 最多等第一个批量任务运行完，之后交互式任务先出队
+      expect(order.indexOf("interactive")).toBeLessThanOrEqual(1);
+      const after = opencv.schedulerStats();
+      expect(after.lanes.bulk.submitted - before.lanes.bulk.submitted).toBe(4);
+      expect(after.lanes.interactive.submitted - before.lanes.interactive.submitted).toBe(1);
+    });
+
+    it("未知的 priority 在提交时抛出异常", () => {
+      const small = new opencv.Mat(8, 8, CV_8UC1, [10]);
+      expect(() => opencv.resizeAsync(small, { width: 4, height: 4 }, { priority: "urgent" })).toThrow(
+        "priority 只能为 'interactive' 或 'bulk'"
+      );
+    });
+  });
+
+  describe("线程预算", () => {
+    let syncThreads: number;
+
+    beforeAll(() => {
+      syncThreads = opencv.getNumThreads();
+    });
+
+    afterEach(() => {
+      opencv.setNumThreads(syncThreads);
+    });
+
+    it("setNumThreads 与 OpenCV 一致：0 为串行，负数恢复为 CPU 核数", () => {
+      expect(opencv.getParallelBackend()).toBe("opencv-napi");
+
+      opencv.setNumThreads(0);
+      expect(opencv.getNumThreads()).toBe(1);
+      opencv.setNumThreads(3);
+      expect(opencv.getNumThreads()).toBe(Math.min(3, syncThreads));
+      opencv.setNumThreads(-1);
+      expect(opencv.getNumThreads()).toBe(syncThreads);
+    });
+
+    it("setNumThreads(1) 不影响异步任务的预算配置", async () => {
+      opencv.schedulerConfigure({ threadsPerJob: 2 });
+      opencv.setNumThreads(1);
+
+      expect(opencv.schedulerStats().threadsPerJob).toBe(2);
+      const result = await opencv.gaussianBlurAsync(big, { width: 5, height: 5 }, 0, { threads: 4 });
+      expect(result.rows).toBe(1500);
+      expect(opencv.getNumThreads()).toBe(1);
+    });
+  });
+
+  it("小任务在调度器中完成并更新 completed", async () => {
+    const before = opencv.schedulerStats();
+    const small = new opencv.Mat(8, 8, CV_8UC1, [10]);
+    const result = await opencv.resizeAsync(small, { width: 4, height: 4 });
+    expect(result.rows).toBe(4);
+    expect(opencv.schedulerStats().completed - before.completed).toBe(1);
+  });
+});
@@ -0,0 +1,51 @@
+import { describe, it, expect } from "vitest";
+import { Worker } from "worker_threads";
+import { addonPath, loadAddon } from "./addon";
+
+const opencv = loadAddon();
+const CV_8UC3 = 16;
+
+// 在 worker 中创建并 transfer() 一个 Mat，把令牌发回主线程后（可选地）等待主线程指示再退出
+function transferFromWorker(waitForAck: boolean): Promise<{ token: number; worker: Worker }> {
+  const code = `
+    const { parentPort, workerData } = require("worker_threads");
+    const opencv = require(workerData.addon);
+    const mat = new opencv.Mat(480, 640, ${CV_8UC3}, [1, 2, 3]);
+    parentPort.postMessage(mat.transfer());
+    if (!workerData.waitForAck) {
+      process.exit(0);
+    }
+    parentPort.once("message", () => process.exit(0));
+  `;
+  const worker = new Worker(code, { eval: true, workerData: { addon: addonPath(), waitForAck } });
+  return new Promise((resolve, reject) => {
+    worker.once("message", (token: number) => resolve({ token, worker }));
+    worker.once("error", reject);
+  });
+}
+
+function exited(worker: Worker): Promise<void> {
+  return new Promise((resolve) => worker.once("exit", () => resolve()));
+}
+
+describe.skipIf(!opencv)("Mat 跨 worker 转移", () => {
+  it("发送方存活时可以领取令牌", async () => {
+    const { token, worker } = await transferFromWorker(true);
+    const mat = opencv.Mat.adopt(token);
+    expect(mat.rows).toBe(480);
+    expect(Array.from(mat.data.subarray(0, 3))).toEqual([1, 2, 3]);
+
+    const done = exited(worker);
+    worker.postMessage("ack");
+    await done;
+  });
+
+  it("发送方 env 退出后未领取的令牌被释放", async () => {
+    const before = opencv.Mat.pendingTransfers();
+    const { token, worker } = await transferFromWorker(false);
+    await exited(worker);
+
+    expect(opencv.Mat.pendingTransfers()).toBe(before);
+    expect(() => opencv.Mat.adopt(token)).toThrow();
+  });
+});